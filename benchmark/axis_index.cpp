@@ -6,6 +6,9 @@
 
 #include <benchmark/benchmark.h>
 #include <boost/histogram/axis.hpp>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace boost::histogram;
 
@@ -31,6 +34,56 @@ static void regular(benchmark::State& state) {
   }
 }
 
+template <bool include_extra_bins>
+static void regular_log(benchmark::State& state) {
+  volatile auto start = 1;
+  volatile auto stop = 11;
+  auto a = axis::regular<double, axis::transform::log>(stop - start, start, stop);
+  for (auto _ : state) {
+    for (int i = 0 - include_extra_bins; i < 10 + include_extra_bins; ++i) {
+      benchmark::DoNotOptimize(i);
+      benchmark::DoNotOptimize(a.index(i + 1));
+    }
+  }
+}
+
+// pow transforms with fixed power, so that they can be template arguments
+template <int numerator, int denominator>
+struct pow_transform : axis::transform::pow {
+  pow_transform() : pow(static_cast<double>(numerator) / denominator) {}
+};
+
+// index_n computes an approximate transform for many values at once
+template <class Transform, bool batch>
+static void regular_transform(benchmark::State& state) {
+  std::vector<double> x(1024);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> dis(0.5, 20);
+  for (auto& xi : x) xi = dis(gen);
+  std::vector<axis::index_type> out(x.size());
+  auto a = axis::regular<double, Transform>(100, 1, 10);
+  for (auto _ : state) {
+    if (batch)
+      a.index_n(x.data(), x.size(), out.data());
+    else
+      for (std::size_t k = 0; k < x.size(); ++k) out[k] = a.index(x[k]);
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
+template <bool include_extra_bins>
+static void log_linear(benchmark::State& state) {
+  volatile auto start = 1;
+  volatile auto stop = 11;
+  auto a = axis::log_linear<>(1, start, stop);
+  for (auto _ : state) {
+    for (int i = 0 - include_extra_bins; i < 10 + include_extra_bins; ++i) {
+      benchmark::DoNotOptimize(i);
+      benchmark::DoNotOptimize(a.index(i + 1));
+    }
+  }
+}
+
 template <bool include_extra_bins>
 static void circular(benchmark::State& state) {
   volatile auto start = 0;
@@ -44,6 +97,25 @@ static void circular(benchmark::State& state) {
   }
 }
 
+// angles from atan2 are within one period of the axis range
+template <int periods, bool batch>
+static void circular_random(benchmark::State& state) {
+  const double pi = 3.141592653589793;
+  std::vector<double> x(1024);
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> dis(-periods * pi, periods * pi);
+  for (auto& xi : x) xi = dis(gen);
+  std::vector<axis::index_type> out(x.size());
+  auto a = axis::circular<>(36, 0, 2 * pi);
+  for (auto _ : state) {
+    if (batch)
+      a.index_n(x.data(), x.size(), out.data());
+    else
+      for (std::size_t k = 0; k < x.size(); ++k) out[k] = a.index(x[k]);
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
 template <bool include_extra_bins>
 static void integer_int(benchmark::State& state) {
   volatile auto start = 0;
@@ -103,12 +175,42 @@ static void variant(benchmark::State& state) {
   }
 }
 
+// strings are longer than the small-string buffer of std::string
+static void category_string(benchmark::State& state) {
+  std::vector<std::string> v;
+  for (int i = 0; i < 10; ++i)
+    v.push_back("category_with_long_name_" + std::to_string(i));
+  auto a = axis::category<std::string>(v);
+  std::vector<const char*> x;
+  for (auto&& s : v) x.push_back(s.c_str());
+  x.push_back("category_not_in_axis");
+  for (auto _ : state) {
+    for (auto&& xi : x) {
+      benchmark::DoNotOptimize(xi);
+      benchmark::DoNotOptimize(axis::traits::index(a, xi));
+    }
+  }
+}
+
 BENCHMARK_TEMPLATE(null, false);
 BENCHMARK_TEMPLATE(null, true);
 BENCHMARK_TEMPLATE(regular, false);
 BENCHMARK_TEMPLATE(regular, true);
+BENCHMARK_TEMPLATE(regular_log, false);
+BENCHMARK_TEMPLATE(regular_log, true);
+BENCHMARK_TEMPLATE(regular_transform, axis::transform::log, false);
+BENCHMARK_TEMPLATE(regular_transform, axis::transform::log, true);
+BENCHMARK_TEMPLATE(regular_transform, pow_transform<1, 2>, false);
+BENCHMARK_TEMPLATE(regular_transform, pow_transform<1, 2>, true);
+BENCHMARK_TEMPLATE(regular_transform, pow_transform<5, 2>, false);
+BENCHMARK_TEMPLATE(regular_transform, pow_transform<5, 2>, true);
+BENCHMARK_TEMPLATE(log_linear, false);
+BENCHMARK_TEMPLATE(log_linear, true);
 BENCHMARK_TEMPLATE(circular, false);
 BENCHMARK_TEMPLATE(circular, true);
+BENCHMARK_TEMPLATE(circular_random, 1, false);
+BENCHMARK_TEMPLATE(circular_random, 1, true);
+BENCHMARK_TEMPLATE(circular_random, 100, false);
 BENCHMARK_TEMPLATE(integer_int, false);
 BENCHMARK_TEMPLATE(integer_int, true);
 BENCHMARK_TEMPLATE(integer_double, false);
@@ -117,3 +219,4 @@ BENCHMARK_TEMPLATE(variable, false);
 BENCHMARK_TEMPLATE(variable, true);
 BENCHMARK_TEMPLATE(category, false);
 BENCHMARK_TEMPLATE(category, true);
+BENCHMARK(category_string);
@@ -0,0 +1,131 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <benchmark/benchmark.h>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/binary.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include "../test/utility_histogram.hpp"
+
+using namespace boost::histogram;
+using reg = axis::regular<>;
+
+template <class Tag, class Storage>
+auto make_filled(int nbins) {
+  auto h = make_s(Tag(), Storage(), reg(nbins, 0, 1), reg(nbins, 0, 1));
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> dis(0, 1);
+  for (int i = 0; i < nbins * nbins; ++i) h(dis(gen), dis(gen), weight(1.5));
+  return h;
+}
+
+template <class Tag, class Storage>
+static void save(benchmark::State& state) {
+  const auto h = make_filled<Tag, Storage>(static_cast<int>(state.range(0)));
+  std::size_t size = 0;
+  for (auto _ : state) {
+    std::ostringstream os(std::ios::binary);
+    save_binary(os, h);
+    size = os.str().size();
+    benchmark::DoNotOptimize(size);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+template <class Tag, class Storage>
+static void load_from_memory(benchmark::State& state) {
+  const auto h = make_filled<Tag, Storage>(static_cast<int>(state.range(0)));
+  std::ostringstream os(std::ios::binary);
+  save_binary(os, h);
+  const auto s = os.str();
+  auto h2 = h;
+  for (auto _ : state) {
+    load_binary(s.data(), s.size(), h2);
+    benchmark::DoNotOptimize(h2);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * s.size()));
+}
+
+template <class Tag, class Storage>
+static void load_from_stream(benchmark::State& state) {
+  const auto h = make_filled<Tag, Storage>(static_cast<int>(state.range(0)));
+  std::ostringstream os(std::ios::binary);
+  save_binary(os, h);
+  const auto s = os.str();
+  auto h2 = h;
+  for (auto _ : state) {
+    std::istringstream is(s, std::ios::binary);
+    load_binary(is, h2);
+    benchmark::DoNotOptimize(h2);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * s.size()));
+}
+
+template <class Tag, class Storage>
+static void load_from_stream_chunked(benchmark::State& state) {
+  const auto h = make_filled<Tag, Storage>(static_cast<int>(state.range(0)));
+  std::ostringstream os(std::ios::binary);
+  save_binary(os, h, binary_encoding::raw, 1 << 16);
+  const auto s = os.str();
+  auto h2 = h;
+  for (auto _ : state) {
+    std::istringstream is(s, std::ios::binary);
+    load_binary(is, h2);
+    benchmark::DoNotOptimize(h2);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * s.size()));
+}
+
+template <class Tag, class Storage>
+static void load_from_memory_parallel(benchmark::State& state) {
+  const auto h = make_filled<Tag, Storage>(static_cast<int>(state.range(0)));
+  std::ostringstream os(std::ios::binary);
+  save_binary(os, h, binary_encoding::raw, 1 << 16);
+  const auto s = os.str();
+  auto h2 = h;
+  for (auto _ : state) {
+    load_binary(execution::par, s.data(), s.size(), h2);
+    benchmark::DoNotOptimize(h2);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * s.size()));
+}
+
+using SStore = std::vector<double>;
+using WStore = weight_storage;
+using DStore = unlimited_storage<>;
+
+BENCHMARK_TEMPLATE(save, static_tag, SStore)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(save, dynamic_tag, SStore)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(save, static_tag, WStore)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(save, static_tag, DStore)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_memory, static_tag, SStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_memory, dynamic_tag, SStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_memory, static_tag, WStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_memory, static_tag, DStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_stream, static_tag, SStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_stream, static_tag, DStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_stream_chunked, static_tag, SStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
+BENCHMARK_TEMPLATE(load_from_memory_parallel, static_tag, SStore)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024);
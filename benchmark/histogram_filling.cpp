@@ -5,10 +5,17 @@
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <benchmark/benchmark.h>
+#include <boost/histogram/auto_range_histogram.hpp>
+#include <boost/histogram/axis/any.hpp>
+#include <boost/histogram/axis/category.hpp>
+#include <boost/histogram/axis/integer.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/variable.hpp>
+#include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
 #include <boost/histogram/unlimited_storage.hpp>
 #include <random>
+#include <vector>
 #include "../test/utility_histogram.hpp"
 
 using namespace boost::histogram;
@@ -62,9 +69,68 @@ static void fill_6d(benchmark::State& state) {
   for (auto _ : state) { h(dis(gen), dis(gen), dis(gen), dis(gen), dis(gen), dis(gen)); }
 }
 
+// dynamic histogram with several axis types, values are generated before the loop
+template <bool Batch>
+static void fill_3d_variant(benchmark::State& state) {
+  using V = axis::variant<reg, axis::variable<>, axis::integer<double>>;
+  auto h = make_histogram(std::vector<V>{reg(100, 0, 1),
+                                         axis::variable<>({0.0, 0.1, 0.5, 1.0}),
+                                         axis::integer<double>(0, 1)});
+  std::default_random_engine gen(1);
+  uniform dis = init<uniform>();
+  std::vector<std::vector<double>> columns(3, std::vector<double>(1 << 12));
+  for (auto&& c : columns)
+    for (auto&& x : c) x = dis(gen);
+  for (auto _ : state) {
+    if (Batch)
+      h.fill(columns);
+    else
+      for (std::size_t i = 0; i < columns[0].size(); ++i)
+        h(columns[0][i], columns[1][i], columns[2][i]);
+  }
+  state.SetItemsProcessed(state.iterations() * columns[0].size());
+}
+
+// dynamic histogram with axes of a wide variant or type-erased axes
+template <class Axis>
+static void fill_3d_dynamic(benchmark::State& state) {
+  auto h = make_histogram(std::vector<Axis>{reg(100, 0, 1), axis::integer<double>(0, 1),
+                                            axis::variable<>({0.0, 0.1, 0.5, 1.0})});
+  std::default_random_engine gen(1);
+  uniform dis = init<uniform>();
+  for (auto _ : state) h(dis(gen), dis(gen), dis(gen));
+}
+
+using wide_variant = axis::variant<reg, axis::regular<double, axis::transform::log>,
+                                   axis::integer<double>, axis::integer<>,
+                                   axis::variable<>, axis::category<>>;
+
 using SStore = std::vector<int>;
 using DStore = unlimited_storage<>;
 
+// 1d histogram for values with unknown range, new histogram in each iteration
+template <bool Auto>
+static void fill_1d_unknown_range(benchmark::State& state) {
+  using growing = axis::regular<double, use_default, use_default, axis::option::growth_t>;
+  using S = storage_adaptor<SStore>;
+  std::default_random_engine gen(1);
+  normal dis{10, 3};
+  std::vector<double> values(1 << 14);
+  for (auto&& x : values) x = dis(gen);
+  for (auto _ : state) {
+    if (Auto) {
+      auto h = auto_range_histogram<reg, S>(100, 1 << 10);
+      h.fill(values);
+      benchmark::DoNotOptimize(h.get().at(0));
+    } else {
+      auto h = histogram<std::tuple<growing>, S>(std::make_tuple(growing(4, 0, 1)));
+      for (auto&& x : values) h(x);
+      benchmark::DoNotOptimize(h.at(0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+
 BENCHMARK_TEMPLATE(fill_1d, static_tag, SStore, uniform);
 BENCHMARK_TEMPLATE(fill_1d, static_tag, DStore, uniform);
 BENCHMARK_TEMPLATE(fill_1d, dynamic_tag, SStore, uniform);
@@ -98,3 +164,10 @@ BENCHMARK_TEMPLATE(fill_6d, static_tag, SStore, normal);
 BENCHMARK_TEMPLATE(fill_6d, static_tag, DStore, normal);
 BENCHMARK_TEMPLATE(fill_6d, dynamic_tag, SStore, normal);
 BENCHMARK_TEMPLATE(fill_6d, dynamic_tag, DStore, normal);
+
+BENCHMARK_TEMPLATE(fill_3d_variant, false);
+BENCHMARK_TEMPLATE(fill_3d_variant, true);
+BENCHMARK_TEMPLATE(fill_3d_dynamic, wide_variant);
+BENCHMARK_TEMPLATE(fill_3d_dynamic, axis::any<>);
+BENCHMARK_TEMPLATE(fill_1d_unknown_range, false);
+BENCHMARK_TEMPLATE(fill_1d_unknown_range, true);
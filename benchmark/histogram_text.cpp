@@ -0,0 +1,58 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <benchmark/benchmark.h>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/text.hpp>
+#include <random>
+#include <sstream>
+
+using namespace boost::histogram;
+using reg = axis::regular<double, axis::transform::log>;
+
+auto make_filled(int nbins) {
+  auto h = make_histogram(reg(nbins, 1, 1e6));
+  std::default_random_engine gen(1);
+  std::uniform_real_distribution<> dis(0, 6);
+  for (int i = 0; i < nbins; ++i) h(std::pow(10, dis(gen)));
+  return h;
+}
+
+// baseline: bin edges and cells formatted with iostreams
+static void ostream_csv(benchmark::State& state) {
+  const auto h = make_filled(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::ostringstream os;
+    os.precision(17);
+    for (auto&& x : indexed(h))
+      os << x.bin().lower() << "," << x.bin().upper() << "," << *x << "\n";
+    benchmark::DoNotOptimize(os.str().size());
+  }
+}
+
+static void csv(benchmark::State& state) {
+  const auto h = make_filled(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::ostringstream os;
+    save_csv(os, h);
+    benchmark::DoNotOptimize(os.str().size());
+  }
+}
+
+static void json(benchmark::State& state) {
+  const auto h = make_filled(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    std::ostringstream os;
+    save_json(os, h);
+    benchmark::DoNotOptimize(os.str().size());
+  }
+}
+
+BENCHMARK(ostream_csv)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(csv)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK(json)->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
@@ -28,16 +28,23 @@
 #include <boost/histogram/accumulators/thread_safe.hpp>
 #include <boost/histogram/accumulators/weighted_mean.hpp>
 #include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/algorithm/cumulative.hpp>
+#include <boost/histogram/algorithm/for_each_bin.hpp>
+#include <boost/histogram/algorithm/merge.hpp>
 #include <boost/histogram/algorithm/project.hpp>
 #include <boost/histogram/algorithm/reduce.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/auto_range_histogram.hpp>
 #include <boost/histogram/axis.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/indexed.hpp>
+#include <boost/histogram/integral_histogram.hpp>
 #include <boost/histogram/literals.hpp>
 #include <boost/histogram/make_histogram.hpp>
 #include <boost/histogram/make_profile.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/span_storage.hpp>
+#include <boost/histogram/tracking_storage.hpp>
 #include <boost/histogram/unlimited_storage.hpp>
 
 #endif
@@ -36,6 +36,7 @@ public:
 
   template <class T>
   mean& operator+=(const mean<T>& rhs) {
+    if (rhs.sum_ == 0) return *this; // empty rhs would give 0/0 if this is empty too
     const auto tmp = mean_ * sum_ + static_cast<RealType>(rhs.mean_ * rhs.sum_);
     sum_ += rhs.sum_;
     mean_ = tmp / sum_;
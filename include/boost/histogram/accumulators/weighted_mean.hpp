@@ -44,6 +44,7 @@ public:
 
   template <typename T>
   weighted_mean& operator+=(const weighted_mean<T>& rhs) {
+    if (rhs.sum_of_weights_ == 0) return *this; // see mean::operator+=
     const auto tmp = weighted_mean_ * sum_of_weights_ +
                      static_cast<RealType>(rhs.weighted_mean_ * rhs.sum_of_weights_);
     sum_of_weights_ += static_cast<RealType>(rhs.sum_of_weights_);
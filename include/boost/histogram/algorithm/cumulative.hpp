@@ -0,0 +1,217 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_CUMULATIVE_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_CUMULATIVE_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/throw_exception.hpp>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+template <class T>
+double cell_as_double(const T& x) {
+  return static_if<std::is_convertible<T, double>>(
+      [](const auto& x) { return static_cast<double>(x); },
+      [](const auto& x) { return static_cast<double>(x.value()); }, x);
+}
+
+} // namespace detail
+
+namespace algorithm {
+
+/** Cumulative distribution along one axis of a histogram.
+
+  Holds the prefix sums of the cell values along the axis and the corresponding bin
+  edges. For histograms with more than one axis, the other axes are summed over, including
+  their underflow and overflow bins (the marginal distribution).
+
+  Quantiles are found with a binary search over the prefix sums and linear interpolation
+  between the edges of the bin which contains the quantile. Cell values must not be
+  negative, otherwise the result is undefined.
+*/
+class cumulative_distribution {
+public:
+  /// Empty distribution, quantile() returns NaN.
+  cumulative_distribution() = default;
+
+  /** Compute cumulative distribution.
+
+    @param h histogram.
+    @param iaxis axis along which the distribution is computed.
+    @param cov whether to include underflow and overflow bins (default: inner).
+    @throws std::invalid_argument if iaxis is not a valid axis index.
+    @throws std::runtime_error if the axis values are not convertible to double.
+  */
+  template <class A, class S>
+  cumulative_distribution(const histogram<A, S>& h, unsigned iaxis,
+                          coverage cov = coverage::inner) {
+    if (iaxis >= h.rank())
+      BOOST_THROW_EXCEPTION(std::invalid_argument("invalid axis index"));
+
+    axis::index_type begin = 0, end = 0;
+    h.for_each_axis([&, d = 0u](const auto& a) mutable {
+      if (d++ != iaxis) return;
+      const auto opt = axis::traits::options(a);
+      const auto n = a.size();
+      const bool all = cov == coverage::all;
+      begin = all && (opt & axis::option::underflow) ? -1 : 0;
+      end = all && (opt & axis::option::overflow) ? n + 1 : n;
+      // flow bins get zero width at the axis boundary, quantiles which fall into them
+      // return the boundary value
+      edges_.clear();
+      edges_.reserve(static_cast<std::size_t>(end - begin + 1));
+      if (begin < 0) edges_.push_back(axis::traits::value_as<double>(a, 0));
+      for (axis::index_type i = 0; i <= n; ++i)
+        edges_.push_back(axis::traits::value_as<double>(a, i));
+      if (end > n) edges_.push_back(edges_.back());
+    });
+
+    values_.assign(edges_.size(), 0.0);
+    for (auto&& x : indexed(h, coverage::all)) {
+      const auto i = x.index(iaxis);
+      if (begin <= i && i < end)
+        values_[static_cast<std::size_t>(i - begin + 1)] += detail::cell_as_double(*x);
+    }
+    for (std::size_t k = 1; k < values_.size(); ++k) values_[k] += values_[k - 1];
+  }
+
+  /// Bin edges, the lower edge of the first bin comes first.
+  const std::vector<double>& edges() const noexcept { return edges_; }
+
+  /// Prefix sums, the k-th entry is the sum over the first k bins, starting with 0.
+  const std::vector<double>& values() const noexcept { return values_; }
+
+  /// Sum over all bins.
+  double total() const noexcept { return values_.back(); }
+
+  /** Compute quantile.
+
+    Returns the value x at which the cumulative distribution reaches the fraction q of the
+    total, interpolating linearly inside the bin. Returns NaN if the total is zero.
+
+    @param q fraction in [0, 1].
+    @throws std::invalid_argument if q is outside of [0, 1].
+  */
+  double quantile(double q) const {
+    if (!(0 <= q && q <= 1))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("q must be in [0, 1]"));
+    const double t = total();
+    if (!(t > 0)) return std::numeric_limits<double>::quiet_NaN();
+    const auto first = values_.begin() + 1;
+    const double target = std::min(q * t, t); // protect against round-off
+    if (target == 0) {
+      // lower edge of first non-empty bin, also if q * t underflows for tiny q
+      const auto it = std::upper_bound(first, values_.end(), 0.0);
+      return edges_[static_cast<std::size_t>(it - first)];
+    }
+    const auto it = std::lower_bound(first, values_.end(), target);
+    const auto k = static_cast<std::size_t>(it - first);
+    const double f = (target - values_[k]) / (values_[k + 1] - values_[k]);
+    return edges_[k] + f * (edges_[k + 1] - edges_[k]);
+  }
+
+private:
+  std::vector<double> edges_{std::numeric_limits<double>::quiet_NaN()}, values_{0.0};
+};
+
+/** Compute cumulative distribution of a one-dimensional histogram.
+
+  @param h histogram.
+  @param cov whether to include underflow and overflow bins (default: inner).
+  @throws std::invalid_argument if histogram has more than one axis.
+*/
+template <class A, class S>
+cumulative_distribution cumulative(const histogram<A, S>& h,
+                                   coverage cov = coverage::inner) {
+  if (h.rank() != 1)
+    BOOST_THROW_EXCEPTION(
+        std::invalid_argument("histogram has more than one axis, select one"));
+  return {h, 0, cov};
+}
+
+/** Compute cumulative distribution of the marginal histogram along one axis.
+
+  @param h histogram.
+  @param iaxis axis along which the distribution is computed.
+  @param cov whether to include underflow and overflow bins (default: inner).
+*/
+template <class A, class S>
+cumulative_distribution cumulative(const histogram<A, S>& h, unsigned iaxis,
+                                   coverage cov = coverage::inner) {
+  return {h, iaxis, cov};
+}
+
+/** Cached quantile lookup for a histogram which is filled in between queries.
+
+  Keeps a reference to the histogram and a cumulative_distribution, which is computed on
+  first use. Filling the histogram through this object invalidates the cache. If the
+  histogram is modified otherwise, call invalidate().
+*/
+template <class Histogram>
+class quantile_index {
+public:
+  /**
+    @param h histogram, must outlive this object.
+    @param iaxis axis along which quantiles are computed (default: 0).
+    @param cov whether to include underflow and overflow bins (default: inner).
+  */
+  explicit quantile_index(Histogram& h, unsigned iaxis = 0,
+                          coverage cov = coverage::inner)
+      : hist_(h), iaxis_(iaxis), cov_(cov) {
+    if (iaxis >= h.rank())
+      BOOST_THROW_EXCEPTION(std::invalid_argument("invalid axis index"));
+  }
+
+  /// Fill histogram and invalidate cache.
+  template <class... Ts>
+  decltype(auto) operator()(Ts&&... ts) {
+    valid_ = false;
+    return hist_(std::forward<Ts>(ts)...);
+  }
+
+  /// Mark cache as outdated.
+  void invalidate() noexcept { valid_ = false; }
+
+  /// Return cumulative distribution, recomputed if the cache is outdated.
+  const cumulative_distribution& cumulative() {
+    if (!valid_) {
+      cdf_ = cumulative_distribution(hist_, iaxis_, cov_);
+      valid_ = true;
+    }
+    return cdf_;
+  }
+
+  /// Compute quantile, see cumulative_distribution::quantile().
+  double quantile(double q) { return cumulative().quantile(q); }
+
+private:
+  Histogram& hist_;
+  unsigned iaxis_;
+  coverage cov_;
+  bool valid_ = false;
+  cumulative_distribution cdf_;
+};
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
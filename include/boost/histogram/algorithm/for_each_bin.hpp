@@ -0,0 +1,59 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_FOR_EACH_BIN_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_FOR_EACH_BIN_HPP
+
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/parallel_for.hpp>
+#include <boost/histogram/execution.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/mp11/function.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace algorithm {
+
+/** Call a function for each bin of a histogram, in parallel if requested.
+
+  The indexed range over the histogram is split into contiguous sub-ranges, which are
+  handed to worker threads. The function is called with an indexed_range::accessor, like
+  the body of a loop over indexed(hist, cov). With execution::par, the function is called
+  concurrently from several threads and must be thread-safe. Each bin is visited exactly
+  once, but the order of the calls is unspecified.
+
+  If the histogram is not const, the function may modify the cell through the accessor.
+  Storages in which a write may affect other cells, like unlimited_storage or storages
+  based on std::map, are then processed in the calling thread. Pass a const histogram to
+  process them in parallel.
+
+  @param policy execution policy.
+  @param hist histogram.
+  @param f function which accepts an indexed_range::accessor.
+  @param cov iteration coverage (optional, default: inner).
+*/
+template <class Policy, class Histogram, class F>
+void for_each_bin(const Policy& policy, Histogram&& hist, F&& f,
+                  coverage cov = coverage::inner) {
+  using H = std::remove_reference_t<Histogram>;
+  using S = typename detail::remove_cvref_t<H>::storage_type;
+  using concurrent = mp11::mp_or<std::is_const<H>, detail::has_independent_writes<S>>;
+  const auto range = indexed(hist, cov);
+  detail::parallel_for_if(concurrent{}, policy, range.size(),
+                          [&range, &f](std::size_t begin, std::size_t end) {
+                            for (auto&& x : range.subrange(begin, end)) f(x);
+                          });
+}
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
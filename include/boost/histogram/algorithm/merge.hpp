@@ -0,0 +1,214 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_ALGORITHM_MERGE_HPP
+#define BOOST_HISTOGRAM_ALGORITHM_MERGE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/parallel_for.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/execution.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/mp11/utility.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// Number of cells which are summed in one tile. A tile of the output is kept in cache
+// while all inputs are added to it.
+constexpr std::size_t merge_tile_size = 2048;
+
+template <class Policy, class S>
+void merge_storage(const Policy& policy, S& s, const std::vector<const S*>& inputs) {
+  parallel_for_if(has_independent_writes<S>{}, policy, s.size(),
+                  [&s, &inputs](std::size_t begin, std::size_t end) {
+                    for (auto tile = begin; tile < end; tile += merge_tile_size) {
+                      const auto n = std::min(merge_tile_size, end - tile);
+                      for (const S* p : inputs) {
+                        auto out = s.begin() + tile;
+                        auto in = p->begin() + tile;
+                        for (std::size_t i = 0; i < n; ++i) *out++ += *in++;
+                      }
+                    }
+                  });
+}
+
+struct merge_adder {
+  template <class T, class U>
+  void operator()(T* out, const U* in, std::size_t n) const {
+    // cannot overflow, output tier was selected accordingly
+    for (std::size_t i = 0; i < n; ++i) out[i] += static_cast<T>(in[i]);
+  }
+
+  template <class A, class U>
+  void operator()(large_int<A>* out, const U* in, std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] += static_cast<std::uint64_t>(in[i]);
+  }
+
+  template <class A>
+  void operator()(large_int<A>* out, const large_int<A>* in, std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] += in[i];
+  }
+};
+
+// Returns largest cell value in [begin, end) of a buffer with integral tier.
+template <class Buffer>
+std::uint64_t merge_max_value(const Buffer& b, std::size_t begin, std::size_t end) {
+  std::uint64_t m = 0;
+  b.visit([&m, begin, end](const auto* tp) {
+    using T = std::decay_t<decltype(*tp)>;
+    static_if<std::is_integral<T>>(
+        [&m, begin, end](const auto* p) {
+          const auto it = std::max_element(p + begin, p + end);
+          if (it != p + end) m = static_cast<std::uint64_t>(*it);
+        },
+        [](const auto*) {}, tp);
+  });
+  return m;
+}
+
+// Returns index of narrowest type which can hold the sum of all buffers. For integral
+// tiers, the bound is the largest sum of the per-tile maxima of the inputs, so that the
+// buffers never need to grow while they are summed concurrently. The tiles are scanned
+// in parallel, like they are summed afterwards.
+template <class Policy, class Buffer>
+unsigned merge_type_index(const Policy& policy, const Buffer& b,
+                          const std::vector<const Buffer*>& bs) {
+  using types = typename Buffer::types;
+  constexpr unsigned large = Buffer::template type_index<mp11::mp_at_c<types, 4>>();
+  constexpr auto max64 = std::numeric_limits<std::uint64_t>::max();
+  const std::uint64_t max_value[4] = {std::numeric_limits<std::uint8_t>::max(),
+                                      std::numeric_limits<std::uint16_t>::max(),
+                                      std::numeric_limits<std::uint32_t>::max(), max64};
+  unsigned tier = b.type;
+  for (const Buffer* x : bs) tier = std::max(tier, static_cast<unsigned>(x->type));
+  if (tier >= large) return tier;
+  // saturates at max64, which then selects large_int
+  std::atomic<std::uint64_t> bound{0};
+  parallel_for(policy, b.size, [&b, &bs, &bound](std::size_t begin, std::size_t end) {
+    std::uint64_t local = 0;
+    for (auto tile = begin; tile < end; tile += merge_tile_size) {
+      const auto tile_end = std::min(tile + merge_tile_size, end);
+      std::uint64_t sum = merge_max_value(b, tile, tile_end);
+      for (const Buffer* x : bs) {
+        const auto m = merge_max_value(*x, tile, tile_end);
+        sum = sum > max64 - m ? max64 : sum + m;
+      }
+      local = std::max(local, sum);
+    }
+    auto cur = bound.load();
+    while (cur < local && !bound.compare_exchange_weak(cur, local)) {}
+  });
+  if (bound == max64) return large;
+  while (tier + 1 < large && bound > max_value[tier]) ++tier;
+  return tier;
+}
+
+template <class Policy, class A>
+void merge_storage(const Policy& policy, unlimited_storage<A>& s,
+                   const std::vector<const unlimited_storage<A>*>& inputs) {
+  auto& b = unsafe_access::unlimited_storage_buffer(s);
+  using buffer_type = remove_cvref_t<decltype(b)>;
+  using types = typename buffer_type::types;
+
+  std::vector<const buffer_type*> buffers;
+  buffers.reserve(inputs.size());
+  for (const auto* p : inputs)
+    buffers.push_back(&unsafe_access::unlimited_storage_buffer(*p));
+
+  // promote output once up front, cells are then summed without overflow checks
+  const unsigned tier = merge_type_index(policy, b, buffers);
+  if (tier > b.type) {
+    b.visit([&b, tier](const auto* tp) {
+      mp11::mp_with_index<mp11::mp_size<types>::value>(tier, [&b, tp](auto i) {
+        b.template make<mp11::mp_at_c<types, i>>(b.size, tp);
+      });
+    });
+  }
+
+  parallel_for(policy, b.size, [&b, &buffers](std::size_t begin, std::size_t end) {
+    b.visit([&buffers, begin, end](auto* out) {
+      for (auto tile = begin; tile < end; tile += merge_tile_size) {
+        const auto n = std::min(merge_tile_size, end - tile);
+        for (const buffer_type* p : buffers)
+          p->visit([out, tile, n](const auto* in) {
+            merge_adder{}(out + tile, in + tile, n);
+          });
+      }
+    });
+  });
+}
+
+} // namespace detail
+
+namespace algorithm {
+
+/** Merge many histograms with identical axes into one by adding their cells.
+
+  This is equivalent to copying the first histogram and adding the others with
+  operator+=, but faster for many inputs. The axes are checked once before the summation
+  starts. The range of cells is then split into tiles and all inputs are added to each
+  tile while it stays in cache. With execution::par, tiles are distributed over threads.
+  Storages which do not support concurrent writes to different cells, like those based on
+  std::map, are always merged in the calling thread.
+
+  If the histograms use unlimited_storage, the output storage is promoted up front to a
+  type which can hold the sum of the largest cell values of the inputs in each tile. The
+  tiles are scanned for these values in parallel, like they are summed afterwards. The
+  result may therefore use a wider type than strictly necessary, but only if the largest
+  values of a tile are in different cells.
+
+  @param hists iterable range of histograms of the same type.
+  @param policy execution policy (optional, default: execution::seq).
+  @returns the merged histogram.
+  @throws std::invalid_argument if the range is empty or the axes differ.
+*/
+template <class Iterable, class Policy = execution::sequenced_policy,
+          class = detail::requires_iterable<Iterable>>
+auto merge(const Iterable& hists, const Policy& policy = {}) {
+  using std::begin;
+  using std::end;
+  auto it = begin(hists);
+  const auto last = end(hists);
+  if (it == last)
+    BOOST_THROW_EXCEPTION(std::invalid_argument("at least one histogram required"));
+  using histogram_type = detail::remove_cvref_t<decltype(*it)>;
+  using storage_type = typename histogram_type::storage_type;
+  using value_type = typename histogram_type::value_type;
+  static_assert(detail::has_operator_radd<value_type>::value,
+                "cell values must support operator+=");
+
+  const histogram_type& first = *it;
+  std::vector<const storage_type*> inputs;
+  while (++it != last) {
+    if (!detail::axes_equal(unsafe_access::axes(first), unsafe_access::axes(*it)))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("axes of histograms differ"));
+    inputs.push_back(&unsafe_access::storage(*it));
+  }
+
+  histogram_type result(first);
+  detail::merge_storage(policy, unsafe_access::storage(result), inputs);
+  return result;
+}
+
+} // namespace algorithm
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -51,7 +51,9 @@ auto project(const histogram<A, S>& h, std::integral_constant<unsigned, N>, Ns..
 
   const auto& old_storage = unsafe_access::storage(h);
   using A2 = decltype(axes);
-  auto result = histogram<A2, S>(std::move(axes), detail::make_default(old_storage));
+  using S2 = detail::owning_storage_t<S>;
+  auto result =
+      histogram<A2, S2>(std::move(axes), detail::make_owning_default(old_storage));
   auto idx = detail::make_stack_buffer<int>(unsafe_access::axes(result));
   for (auto x : indexed(h, coverage::all)) {
     auto i = idx.begin();
@@ -83,8 +85,8 @@ auto project(const histogram<A, S>& h, const Iterable& c) {
   }
 
   const auto& old_storage = unsafe_access::storage(h);
-  auto result =
-      histogram<decltype(axes), S>(std::move(axes), detail::make_default(old_storage));
+  auto result = histogram<decltype(axes), detail::owning_storage_t<S>>(
+      std::move(axes), detail::make_owning_default(old_storage));
   auto idx = detail::make_stack_buffer<int>(unsafe_access::axes(result));
   for (auto x : indexed(h, coverage::all)) {
     auto i = idx.begin();
@@ -168,7 +168,8 @@ inline reduce_option rebin(unsigned merge) { return rebin(0, merge); }
 /**
   Shrink, slice, and/or rebin axes of a histogram.
 
-  Returns the reduced copy of the histogram.
+  Returns the reduced copy of the histogram. If the histogram does not own its cells, like
+  a histogram view, the copy uses an owning storage.
 
   Shrinking only works with axes that accept double values. Some axis types do not support
   the reduce operation, for example, the builtin category axis, which is not ordered.
@@ -265,8 +266,9 @@ decltype(auto) reduce(const Histogram& hist, const Iterable& options) {
     ++iaxis;
   });
 
-  auto storage = detail::make_default(unsafe_access::storage(hist));
-  auto result = Histogram(std::move(axes), std::move(storage));
+  using S = detail::owning_storage_t<typename Histogram::storage_type>;
+  auto result = histogram<detail::remove_cvref_t<decltype(axes)>, S>(
+      std::move(axes), detail::make_owning_default(unsafe_access::storage(hist)));
 
   auto idx = detail::make_stack_buffer<int>(unsafe_access::axes(result));
   for (auto x : indexed(hist, coverage::all)) {
@@ -0,0 +1,224 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AUTO_RANGE_HISTOGRAM_HPP
+#define BOOST_HISTOGRAM_AUTO_RANGE_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/** One-dimensional histogram which chooses the range of its regular axis from the data.
+
+  The first values are stored in a buffer. When the buffer is full, or when freeze() is
+  called, the range of the axis is set to the interval between the lower and the upper
+  quantile of the buffered values. The histogram is then created with this axis, the
+  buffered values are filled in one batch, and the buffer is released. All later values
+  are filled directly into the histogram, which has a regular axis that never grows.
+
+  Compared to a regular axis with the growth option, the storage is allocated only once
+  and the fill path does not need to check for axis growth. Values outside of the chosen
+  range are counted in the underflow and overflow bins, if the axis has them. Buffered
+  NaN values are ignored when the range is computed. If the buffered values do not span
+  a finite interval, the range is set to a unit interval around their value, or to
+  [0, 1) if there are no finite values. The unit interval is widened for values so large
+  that it is smaller than their precision. A range wider than the largest finite double
+  is cut symmetrically around its center.
+
+  Only unweighted fills of single values are supported. The class is not thread-safe.
+
+  @tparam Axis regular axis type, must be constructible from the number of bins, the
+               range, and the metadata.
+  @tparam Storage storage type of the histogram.
+*/
+template <class Axis = axis::regular<>, class Storage = default_storage>
+class auto_range_histogram {
+public:
+  using axis_type = Axis;
+  using metadata_type =
+      std::decay_t<decltype(axis::traits::metadata(std::declval<axis_type&>()))>;
+  using histogram_type = histogram<std::tuple<axis_type>, Storage>;
+
+  /** Create empty histogram which buffers values before its range is chosen.
+
+    @param bins number of bins of the axis.
+    @param buffer_size number of values which are buffered before the range is chosen.
+    @param lower_quantile quantile of buffered values used as lower edge (default: 0).
+    @param upper_quantile quantile of buffered values used as upper edge (default: 1).
+    @param meta metadata of the axis (optional).
+    @param storage storage instance used for the histogram (optional).
+  */
+  auto_range_histogram(unsigned bins, std::size_t buffer_size, double lower_quantile = 0,
+                       double upper_quantile = 1, metadata_type meta = {},
+                       Storage storage = Storage())
+      : bins_(bins)
+      , buffer_size_(buffer_size)
+      , lower_quantile_(lower_quantile)
+      , upper_quantile_(upper_quantile)
+      , meta_(std::move(meta))
+      , storage_(std::move(storage)) {
+    if (bins == 0) BOOST_THROW_EXCEPTION(std::invalid_argument("bins > 0 required"));
+    if (buffer_size == 0)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("buffer_size > 0 required"));
+    if (!(0 <= lower_quantile && lower_quantile < upper_quantile && upper_quantile <= 1))
+      BOOST_THROW_EXCEPTION(std::invalid_argument(
+          "0 <= lower_quantile < upper_quantile <= 1 required"));
+    buffer_.reserve(buffer_size);
+  }
+
+  /// Fill histogram with value, the value is buffered if the range is not chosen yet.
+  void operator()(double x) {
+    if (frozen_) {
+      hist_(x);
+      return;
+    }
+    buffer_.push_back(x);
+    if (buffer_.size() == buffer_size_) freeze();
+  }
+
+  /** Fill histogram with many values at once.
+
+    Values are buffered until the buffer is full, the remaining values are filled into
+    the histogram in one batch, see histogram::fill().
+
+    @param values random-access iterable of values.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& values) {
+    using std::begin;
+    using std::end;
+    auto first = begin(values);
+    const auto last = end(values);
+    if (!frozen_) {
+      const auto m = std::min(static_cast<std::size_t>(std::distance(first, last)),
+                              buffer_size_ - buffer_.size());
+      buffer_.insert(buffer_.end(), first, first + m);
+      first += m;
+      if (buffer_.size() == buffer_size_) freeze();
+    }
+    if (first != last) {
+      const std::array<column<decltype(first)>, 1> columns{{{first, last}}};
+      hist_.fill(columns);
+    }
+  }
+
+  /** Choose range from buffered values and create the histogram.
+
+    Calling this is only needed when fewer values than the buffer size were filled.
+    Has no effect if the range was already chosen.
+  */
+  void freeze() {
+    if (frozen_) return;
+    // buffer is filled in any order, so it can be partially sorted in place
+    const auto n = static_cast<std::size_t>(
+        std::partition(buffer_.begin(), buffer_.end(),
+                       [](double x) { return !std::isnan(x); }) -
+        buffer_.begin());
+    double lower = 0.5, upper = 0.5;
+    if (n > 0) {
+      lower = quantile(lower_quantile_, n);
+      upper = quantile(upper_quantile_, n);
+    }
+    if (!std::isfinite(lower) || !std::isfinite(upper)) lower = upper = 0.5;
+    auto a = make_axis(lower, upper);
+    hist_ = histogram_type(std::make_tuple(std::move(a)), std::move(storage_));
+    const std::array<column<std::vector<double>::const_iterator>, 1> columns{
+        {{buffer_.cbegin(), buffer_.cend()}}};
+    hist_.fill(columns);
+    std::vector<double>().swap(buffer_);
+    frozen_ = true;
+  }
+
+  /// Returns true if the range was chosen and the histogram was created.
+  bool frozen() const noexcept { return frozen_; }
+
+  /// Returns number of values in the buffer.
+  std::size_t buffered() const noexcept { return buffer_.size(); }
+
+  /// Returns the histogram, the range is chosen first if needed.
+  histogram_type& get() {
+    freeze();
+    return hist_;
+  }
+
+private:
+  template <class It>
+  struct column {
+    It first, last;
+    It begin() const { return first; }
+    It end() const { return last; }
+  };
+
+  // value at position floor(q * (n - 1)) of the sorted buffer
+  double quantile(double q, std::size_t n) {
+    const auto last = buffer_.begin() + static_cast<std::ptrdiff_t>(n);
+    // default range needs no partial sort
+    if (q == 0) return *std::min_element(buffer_.begin(), last);
+    if (q == 1) return *std::max_element(buffer_.begin(), last);
+    const auto it =
+        buffer_.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(n - 1));
+    std::nth_element(buffer_.begin(), it, last);
+    return *it;
+  }
+
+  // axis for finite lower <= upper
+  axis_type make_axis(double lower, double upper) const {
+    constexpr auto max = std::numeric_limits<double>::max();
+    if (lower == upper) {
+      // unit interval, or a few ulp if the value is so large that x + 0.5 == x
+      const auto x = lower;
+      const auto w = std::max(0.5, 4 * (std::abs(x) - std::nextafter(std::abs(x), 0.0)));
+      return axis_type(bins_, std::max(x - w, -max), std::min(x + w, max), meta_);
+    }
+    if (!std::isfinite(upper - lower)) {
+      // width must be finite, so the range is cut symmetrically around its center and
+      // the outermost values are counted in the underflow and overflow bins
+      const auto mid = 0.5 * lower + 0.5 * upper;
+      lower = mid - max / 4;
+      upper = mid + max / 4;
+    }
+    // upper edge of regular axis is exclusive, widen it until upper is in the last bin
+    auto a = axis_type(bins_, lower, upper, meta_);
+    auto step = std::nextafter(upper, std::numeric_limits<double>::infinity()) - upper;
+    while (a.index(upper) >= a.size() && std::isfinite(upper + step - lower)) {
+      a = axis_type(bins_, lower, upper + step, meta_);
+      step *= 2;
+    }
+    return a;
+  }
+
+  unsigned bins_;
+  std::size_t buffer_size_;
+  double lower_quantile_, upper_quantile_;
+  metadata_type meta_;
+  Storage storage_;
+  std::vector<double> buffer_;
+  histogram_type hist_;
+  bool frozen_ = false;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
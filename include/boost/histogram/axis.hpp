@@ -7,9 +7,15 @@
 #ifndef BOOST_HISTOGRAM_AXIS_HPP
 #define BOOST_HISTOGRAM_AXIS_HPP
 
+#include <boost/histogram/axis/any.hpp>
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/interned_string.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_integer.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/axis/top_k_category.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
 
@@ -0,0 +1,289 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_ANY_HPP
+#define BOOST_HISTOGRAM_AXIS_ANY_HPP
+
+#include <boost/core/typeinfo.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/polymorphic_bin.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/cat.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/detail/type_name.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// table of functions which implement the axis::any interface for one axis type
+template <class M>
+struct any_vtable {
+  axis::index_type (*index)(const void*, double);
+  axis::index_type (*linear_index)(const void*, double, axis::index_type&);
+  std::pair<axis::index_type, axis::index_type> (*update)(void*, double);
+  double (*value)(const void*, axis::real_index_type);
+  axis::polymorphic_bin<double> (*bin)(const void*, axis::index_type);
+  axis::index_type (*size)(const void*);
+  unsigned (*options)(const void*);
+  M* (*metadata)(void*);
+  bool (*equal)(const void*, const void*);
+  void* (*clone)(const void*);
+  void* (*reduce)(const void*, axis::index_type, axis::index_type, unsigned);
+  void (*destroy)(void*);
+  std::string (*name)();
+  // tables of the same axis type may differ across shared libraries, compare this
+  const core::typeinfo* type;
+};
+
+template <class M, class A>
+const any_vtable<M>& make_any_vtable() noexcept {
+  static const any_vtable<M> vt = {
+      [](const void* p, double x) -> axis::index_type {
+        return axis::traits::index(*static_cast<const A*>(p), x);
+      },
+      [](const void* p, double x, axis::index_type& extent) -> axis::index_type {
+        const auto& a = *static_cast<const A*>(p);
+        extent = axis::traits::extent(a);
+        return axis::traits::index(a, x) +
+               (axis::traits::options(a) & axis::option::underflow ? 1 : 0);
+      },
+      [](void* p, double x) { return axis::traits::update(*static_cast<A*>(p), x); },
+      [](const void* p, axis::real_index_type i) {
+        return axis::traits::value_as<double>(*static_cast<const A*>(p), i);
+      },
+      [](const void* p, axis::index_type i) {
+        return value_method_switch(
+            [i](const auto& a) { // axis is discrete
+              const double x = axis::traits::value_as<double>(a, i);
+              return axis::polymorphic_bin<double>(x, x);
+            },
+            [i](const auto& a) { // axis is continuous
+              const double x1 = axis::traits::value_as<double>(a, i);
+              const double x2 = axis::traits::value_as<double>(a, i + 1);
+              return axis::polymorphic_bin<double>(x1, x2);
+            },
+            *static_cast<const A*>(p));
+      },
+      [](const void* p) -> axis::index_type { return static_cast<const A*>(p)->size(); },
+      [](const void* p) { return axis::traits::options(*static_cast<const A*>(p)); },
+      [](void* p) -> M* {
+        return static_if<std::is_same<decltype(axis::traits::metadata(
+                                          std::declval<A&>())),
+                                      M&>>(
+            [](auto& a) -> M* { return &axis::traits::metadata(a); },
+            [](auto&) -> M* { return nullptr; }, *static_cast<A*>(p));
+      },
+      [](const void* p, const void* q) {
+        return relaxed_equal(*static_cast<const A*>(p), *static_cast<const A*>(q));
+      },
+      [](const void* p) -> void* { return new A(*static_cast<const A*>(p)); },
+      [](const void* p, axis::index_type begin, axis::index_type end,
+         unsigned merge) -> void* {
+        return static_if<axis::traits::is_reducible<A>>(
+            [begin, end, merge](const auto& a) -> void* {
+              return new A(a, begin, end, merge);
+            },
+            [](const auto&) -> void* {
+              BOOST_THROW_EXCEPTION(std::invalid_argument(
+                  cat(type_name<A>(), " is not reducible")));
+#ifndef _MSC_VER // msvc warns about unreachable return
+              return nullptr;
+#endif
+            },
+            *static_cast<const A*>(p));
+      },
+      [](void* p) { delete static_cast<A*>(p); },
+      []() { return type_name<A>(); },
+      &BOOST_CORE_TYPEID(A)};
+  return vt;
+}
+
+} // namespace detail
+
+namespace axis {
+
+template <class T, class M>
+T* get_if(any<M>*);
+
+template <class T, class M>
+const T* get_if(const any<M>*);
+
+/**
+  Type-erased axis which can hold any axis type.
+
+  Like axis::variant, any can hold axes of different types, but the types need not be
+  listed as template arguments. The axis is stored on the heap and all calls go through
+  a table of function pointers, which is created once for each axis type that is stored.
+  A histogram with any axes therefore instantiates the code for filling and the
+  algorithms only once, independent of how many axis types are used, which reduces
+  compile times and binary size compared to a wide axis::variant. A call through an
+  any is a bit slower than a call through axis::variant, which can be inlined.
+
+  Values are passed to the stored axis as double, so any cannot hold axes which do not
+  accept numbers, like category<std::string>. A default-constructed any holds no axis;
+  it can only be assigned to, compared, or destroyed. Serialization and streaming are
+  not supported. Use axis::get_if and axis::get to access the stored axis.
+
+  @tparam MetaData type of metadata which is returned by metadata(); axes with another
+                   metadata type can be stored, but their metadata is not accessible.
+ */
+template <class MetaData>
+class any : public iterator_mixin<any<MetaData>> {
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using vtable_type = detail::any_vtable<metadata_type>;
+
+  template <class T>
+  using requires_other_axis =
+      std::enable_if_t<(detail::is_axis<detail::remove_cvref_t<T>>::value &&
+                        !std::is_same<detail::remove_cvref_t<T>, any>::value)>;
+
+public:
+  any() = default;
+
+  any(const any& o) : vt_(o.vt_), ptr_(o.vt_ ? o.vt_->clone(o.ptr_) : nullptr) {}
+
+  any& operator=(const any& o) {
+    if (this != &o) *this = any(o);
+    return *this;
+  }
+
+  any(any&& o) noexcept : vt_(o.vt_), ptr_(o.ptr_) {
+    o.vt_ = nullptr;
+    o.ptr_ = nullptr;
+  }
+
+  any& operator=(any&& o) noexcept {
+    std::swap(vt_, o.vt_);
+    std::swap(ptr_, o.ptr_);
+    return *this;
+  }
+
+  /// Construct from axis instance.
+  template <class T, class = requires_other_axis<T>>
+  any(T&& t)
+      : vt_(&detail::make_any_vtable<metadata_type, detail::remove_cvref_t<T>>())
+      , ptr_(new detail::remove_cvref_t<T>(std::forward<T>(t))) {}
+
+  /// Assign axis instance.
+  template <class T, class = requires_other_axis<T>>
+  any& operator=(T&& t) {
+    return *this = any(std::forward<T>(t));
+  }
+
+  /// Constructor used by algorithm::reduce to shrink and rebin (not for users).
+  any(const any& src, index_type begin, index_type end, unsigned merge)
+      : vt_(src.vt_), ptr_(src.vt_->reduce(src.ptr_, begin, end, merge)) {}
+
+  ~any() {
+    if (vt_) vt_->destroy(ptr_);
+  }
+
+  /// Return index for value argument.
+  index_type index(double x) const { return vt_->index(ptr_, x); }
+
+  /// Return index shifted by one if axis has underflow bin, and extent of the axis, used
+  /// by the fill code of histogram (not for users).
+  index_type linear_index(double x, index_type& extent) const {
+    return vt_->linear_index(ptr_, x, extent);
+  }
+
+  /// Return index for value argument and shift, growing the axis if it has growth option.
+  std::pair<index_type, index_type> update(double x) { return vt_->update(ptr_, x); }
+
+  /// Return value for index argument, see axis::traits::value().
+  double value(real_index_type idx) const { return vt_->value(ptr_, idx); }
+
+  /// Return bin for index argument, see axis::variant::bin().
+  polymorphic_bin<double> bin(index_type idx) const { return vt_->bin(ptr_, idx); }
+
+  /// Returns the number of bins, without over- or underflow.
+  index_type size() const { return vt_->size(ptr_); }
+
+  /// Returns the options of the stored axis.
+  unsigned options() const { return vt_->options(ptr_); }
+
+  /// Return reference to metadata, throws std::runtime_error if the stored axis has
+  /// another metadata type.
+  metadata_type& metadata() {
+    auto m = vt_->metadata(ptr_);
+    if (!m)
+      BOOST_THROW_EXCEPTION(std::runtime_error(
+          detail::cat("cannot return metadata of ", vt_->name(),
+                      " through axis::any interface which uses type ",
+                      detail::type_name<metadata_type>())));
+    return *m;
+  }
+
+  /// Return reference to const metadata, throws std::runtime_error if the stored axis
+  /// has another metadata type.
+  const metadata_type& metadata() const { return const_cast<any&>(*this).metadata(); }
+
+  bool operator==(const any& o) const {
+    if (!vt_ || !o.vt_) return vt_ == o.vt_;
+    return *vt_->type == *o.vt_->type && vt_->equal(ptr_, o.ptr_);
+  }
+
+  template <class T>
+  bool operator==(const T& t) const {
+    const T* tp = get_if<T>(this);
+    return tp && detail::relaxed_equal(*tp, t);
+  }
+
+  template <class T>
+  bool operator!=(const T& t) const {
+    return !operator==(t);
+  }
+
+private:
+  const vtable_type* vt_ = nullptr;
+  void* ptr_ = nullptr;
+
+  template <class T, class M>
+  friend T* get_if(any<M>*);
+};
+
+/// Returns pointer to T in any or null pointer if type does not match.
+template <class T, class M>
+T* get_if(any<M>* a) {
+  return a->vt_ && *a->vt_->type == BOOST_CORE_TYPEID(T) ? static_cast<T*>(a->ptr_)
+                                                          : nullptr;
+}
+
+/// Returns pointer to const T in any or null pointer if type does not match.
+template <class T, class M>
+const T* get_if(const any<M>* a) {
+  return get_if<T>(const_cast<any<M>*>(a));
+}
+
+/// Return reference to T, throws std::runtime_error if type does not match.
+template <class T, class M>
+T& get(any<M>& a) {
+  auto tp = get_if<T>(&a);
+  if (!tp)
+    BOOST_THROW_EXCEPTION(std::runtime_error(
+        detail::cat("axis::any does not hold ", detail::type_name<T>())));
+  return *tp;
+}
+
+/// Return reference to const T, throws std::runtime_error if type does not match.
+template <class T, class M>
+const T& get(const any<M>& a) {
+  return get<T>(const_cast<any<M>&>(a));
+}
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
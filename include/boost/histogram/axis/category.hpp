@@ -12,15 +12,60 @@
 #include <boost/histogram/axis/option.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstddef>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace boost {
 namespace histogram {
+namespace detail {
+
+// Non-owning reference to characters, used to look up strings in a category axis without
+// making a temporary copy. Implicitly constructible from null-terminated strings and from
+// any type with data() and size(), like std::string and std::string_view.
+template <class C, class T>
+class basic_string_key {
+public:
+  basic_string_key(const C* s) noexcept : data_(s), size_(T::length(s)) {}
+
+  template <class S, class = std::enable_if_t<std::is_convertible<
+                         decltype(std::declval<const S&>().data()), const C*>::value>,
+            class = decltype(std::declval<const S&>().size())>
+  basic_string_key(const S& s) noexcept : data_(s.data()), size_(s.size()) {}
+
+  const C* data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+
+private:
+  const C* data_;
+  std::size_t size_;
+};
+
+template <class C, class T, class A>
+bool operator==(const std::basic_string<C, T, A>& a,
+                const basic_string_key<C, T>& b) noexcept {
+  return a.size() == b.size() && T::compare(a.data(), b.data(), b.size()) == 0;
+}
+
+// argument type of category::index, which differs from the value type for strings
+template <class T>
+struct category_key {
+  using type = T;
+};
+
+template <class C, class T, class A>
+struct category_key<std::basic_string<C, T, A>> {
+  using type = basic_string_key<C, T>;
+};
+
+} // namespace detail
+
 namespace axis {
 
 /**
@@ -31,6 +76,11 @@ namespace axis {
   are not part of the set. Binning has O(N) complexity, but with a very small
   factor. For small N (the typical use case) it beats other kinds of lookup.
 
+  If the value type is std::string, the axis accepts any string-like argument, for
+  example, a null-terminated string or std::string_view, and compares it with the
+  stored strings without making a copy. A growing axis copies the argument only when
+  it adds a new bin.
+
   @tparam Value input value type, must be equal-comparable.
   @tparam MetaData type to store meta data.
   @tparam Options see boost::histogram::axis::option.
@@ -42,6 +92,7 @@ namespace axis {
 template <class Value, class MetaData, class Options, class Allocator>
 class category : public iterator_mixin<category<Value, MetaData, Options, Allocator>> {
   using value_type = Value;
+  using key_type = typename detail::category_key<value_type>::type;
   using metadata_type = detail::replace_default<MetaData, std::string>;
   using options_type = detail::replace_default<Options, option::overflow_t>;
   static_assert(!options_type::test(option::underflow),
@@ -93,17 +144,20 @@ public:
       : category(list.begin(), list.end(), std::move(meta), std::move(alloc)) {}
 
   /// Return index for value argument.
-  index_type index(const value_type& x) const noexcept {
+  index_type index(const key_type& x) const noexcept {
     const auto beg = vec_meta_.first().begin();
     const auto end = vec_meta_.first().end();
     return static_cast<index_type>(std::distance(beg, std::find(beg, end, x)));
   }
 
   /// Returns index and shift (if axis has grown) for the passed argument.
-  auto update(const value_type& x) {
+  auto update(const key_type& x) {
     const auto i = index(x);
     if (i < size()) return std::make_pair(i, 0);
-    vec_meta_.first().emplace_back(x);
+    detail::static_if<std::is_same<key_type, value_type>>(
+        [](auto& vec, const auto& x) { vec.emplace_back(x); },
+        [](auto& vec, const auto& x) { vec.emplace_back(x.data(), x.size()); },
+        vec_meta_.first(), x);
     return std::make_pair(i, -1);
   }
 
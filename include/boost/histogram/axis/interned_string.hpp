@@ -0,0 +1,119 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_INTERNED_STRING_HPP
+#define BOOST_HISTOGRAM_AXIS_INTERNED_STRING_HPP
+
+#include <boost/histogram/fwd.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// Pool of interned strings. An entry is removed when the last interned_string which
+// refers to it is destroyed. The pool is never destroyed, because interned strings in
+// static objects may be destroyed after it.
+struct interned_string_pool {
+  using pointer = std::shared_ptr<const std::string>;
+
+  static interned_string_pool& instance() {
+    static auto p = new interned_string_pool;
+    return *p;
+  }
+
+  pointer intern(std::string s) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = map_[s];
+    auto p = entry.lock();
+    if (!p) {
+      p = pointer(new std::string(std::move(s)), [this](const std::string* x) {
+        release(x);
+      });
+      entry = p;
+    }
+    return p;
+  }
+
+  std::size_t size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.size();
+  }
+
+private:
+  void release(const std::string* x) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // the entry may already refer to a new copy of the string
+      auto it = map_.find(*x);
+      if (it != map_.end() && it->second.expired()) map_.erase(it);
+    }
+    delete x;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<const std::string>> map_;
+};
+
+} // namespace detail
+
+namespace axis {
+
+/**
+  Immutable string which is stored once for all equal strings.
+
+  Use this as metadata type of an axis to make copies of histograms and comparisons of
+  axes cheap, for example, when many small histograms with the same labels are merged.
+  Equal strings share one reference-counted copy, so copying is a pointer copy and
+  comparing two interned strings is a pointer comparison. Creating an interned string
+  looks up the string in a global pool, which is protected by a mutex.
+*/
+class interned_string {
+public:
+  /// Make empty string.
+  interned_string() noexcept = default;
+
+  /// Make interned copy of string.
+  interned_string(std::string s) {
+    if (!s.empty()) ptr_ = detail::interned_string_pool::instance().intern(std::move(s));
+  }
+
+  /// Make interned copy of null-terminated string.
+  interned_string(const char* s) : interned_string(std::string(s)) {}
+
+  /// Return reference to the string.
+  const std::string& str() const noexcept { return ptr_ ? *ptr_ : empty_string(); }
+
+  /// Return pointer to null-terminated string.
+  const char* c_str() const noexcept { return str().c_str(); }
+
+  /// Return true if the string is empty.
+  bool empty() const noexcept { return !ptr_; }
+
+  bool operator==(const interned_string& rhs) const noexcept { return ptr_ == rhs.ptr_; }
+  bool operator!=(const interned_string& rhs) const noexcept { return !operator==(rhs); }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static const std::string& empty_string() noexcept {
+    static const std::string s;
+    return s;
+  }
+
+  std::shared_ptr<const std::string> ptr_;
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,281 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+#define BOOST_HISTOGRAM_AXIS_LOG_LINEAR_HPP
+
+#include <boost/histogram/axis/interval_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/compressed_pair.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// x must not be zero
+inline unsigned bit_width_minus_one(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long n;
+  _BitScanReverse64(&n, x);
+  return static_cast<unsigned>(n);
+#else
+  unsigned n = 0;
+  while (x >>= 1) ++n;
+  return n;
+#endif
+}
+
+} // namespace detail
+
+namespace axis {
+
+/**
+  Axis with log-linear bins like in a HdrHistogram, for example, for latencies.
+
+  Each interval [2^k, 2^(k+1)) is divided into 2^m equal bins, where m is the smallest
+  number so that 2^m >= 10^digits. The width of each bin relative to its lower edge is
+  therefore at most 10^-digits. Binning is a O(1) operation which uses only integer and
+  bit operations: for floating point values, the bin is obtained from the exponent and
+  the leading m bits of the mantissa, for integral values from the position of the
+  leading bit. Binning is much faster than for a regular axis with log transform.
+
+  For integral values, the bins below 2^m have unit width, because the bins in these
+  intervals cannot be narrower than one.
+
+  @tparam Value input value type, must be floating point or integral.
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (circular and growth not allowed).
+ */
+template <class Value, class MetaData, class Options>
+class log_linear : public iterator_mixin<log_linear<Value, MetaData, Options>> {
+  static_assert(std::is_floating_point<Value>::value || std::is_integral<Value>::value,
+                "log_linear axis requires floating point or integral type");
+  static_assert(!std::is_floating_point<Value>::value ||
+                    (std::numeric_limits<Value>::is_iec559 &&
+                     (sizeof(Value) == 4 || sizeof(Value) == 8)),
+                "log_linear axis requires IEEE 754 float or double");
+
+  using value_type = Value;
+  using real_value_type = detail::convert_integer<value_type, double>;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(!options_type::test(option::circular) &&
+                    !options_type::test(option::growth),
+                "log_linear axis does not support circular or growth options");
+
+  using bits_type =
+      std::conditional_t<sizeof(value_type) == 4, std::uint32_t, std::uint64_t>;
+
+public:
+  constexpr log_linear() = default;
+
+  /** Construct bins over range [start, stop) with given relative precision.
+   *
+   * @param digits   number of significant decimal digits of the bin edges.
+   * @param start    low edge of first bin (see below), must be positive for floating
+   *                 point types and not negative for integral types.
+   * @param stop     upper limit of high edge of last bin (see below).
+   * @param meta     description of the axis (optional).
+   *
+   * The lower edge of the first bin is the largest bin edge <= start and the upper
+   * edge of the last bin is the smallest bin edge >= stop.
+   */
+  log_linear(unsigned digits, value_type start, value_type stop,
+             metadata_type meta = {})
+      : size_meta_(0, std::move(meta)) {
+    if (digits == 0)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("digits > 0 required"));
+    double p = 1;
+    for (unsigned i = 0; i < digits; ++i) p *= 10;
+    while (bits_ <= max_bits() && static_cast<double>(std::uint64_t{1} << bits_) < p)
+      ++bits_;
+    if (bits_ > max_bits())
+      BOOST_THROW_EXCEPTION(std::invalid_argument("digits too large for value type"));
+    detail::static_if<std::is_floating_point<value_type>>(
+        [](auto start, auto stop) {
+          // start of zero would add 2^m bins for each power of two down to the denormals
+          if (!(start > 0))
+            BOOST_THROW_EXCEPTION(std::invalid_argument("start > 0 required"));
+          if (!std::isfinite(stop))
+            BOOST_THROW_EXCEPTION(std::invalid_argument("stop must be finite"));
+        },
+        [](auto start, auto) {
+          if (!(static_cast<double>(start) >= 0))
+            BOOST_THROW_EXCEPTION(std::invalid_argument("start >= 0 required"));
+        },
+        start, stop);
+    if (!(start < stop))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("start < stop required"));
+    min_ = global_index(start);
+    auto max = global_index(stop);
+    if (lower_edge(max) < static_cast<real_value_type>(stop)) ++max;
+    if (max - min_ > static_cast<std::uint64_t>(std::numeric_limits<index_type>::max()))
+      BOOST_THROW_EXCEPTION(std::invalid_argument("too many bins"));
+    size_meta_.first() = static_cast<index_type>(max - min_);
+  }
+
+  /// Constructor used by algorithm::reduce to shrink and rebin (not for users).
+  log_linear(const log_linear& src, index_type begin, index_type end, unsigned merge)
+      : size_meta_(end - begin, src.metadata())
+      , bits_(src.bits_)
+      , min_(src.min_ + static_cast<std::uint64_t>(begin)) {
+    if (merge > 1)
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("cannot merge bins for log_linear axis"));
+  }
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    const auto k = global_index(x) - min_;
+    if (k < static_cast<std::uint64_t>(size())) return static_cast<index_type>(k);
+    const auto lower = value(0);
+    if (static_cast<real_value_type>(x) < lower) return -1;
+    // x is -0.0 and lower edge is zero, if start is in the first bin of denormals
+    if (static_cast<real_value_type>(x) == lower) return 0;
+    return size(); // also returned if x is NaN
+  }
+
+  /// Return value for fractional index argument.
+  real_value_type value(real_index_type i) const noexcept {
+    if (i < 0) return -std::numeric_limits<real_value_type>::infinity();
+    if (i > size()) return std::numeric_limits<real_value_type>::infinity();
+    const auto k = std::floor(i);
+    const auto a = lower_edge(min_ + static_cast<std::uint64_t>(k));
+    if (k == i) return a;
+    const auto b = lower_edge(min_ + static_cast<std::uint64_t>(k) + 1);
+    return a + static_cast<real_value_type>(i - k) * (b - a);
+  }
+
+  /// Return bin for index argument.
+  decltype(auto) bin(index_type idx) const noexcept {
+    return interval_view<log_linear>(*this, idx);
+  }
+
+  /// Returns the number of bins, without over- or underflow.
+  index_type size() const noexcept { return size_meta_.first(); }
+  /// Returns number of bins per factor of two.
+  std::uint64_t bins_per_octave() const noexcept { return std::uint64_t{1} << bits_; }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return size_meta_.second(); }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return size_meta_.second(); }
+
+  template <class V, class M, class O>
+  bool operator==(const log_linear<V, M, O>& o) const noexcept {
+    return size() == o.size() && detail::relaxed_equal(metadata(), o.metadata()) &&
+           bits_ == o.bits_ && min_ == o.min_;
+  }
+  template <class V, class M, class O>
+  bool operator!=(const log_linear<V, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static constexpr unsigned max_bits() noexcept {
+    return std::is_floating_point<value_type>::value
+               ? std::numeric_limits<value_type>::digits - 1
+               : 30;
+  }
+
+  static bits_type to_bits(value_type x) noexcept {
+    bits_type b;
+    std::memcpy(&b, &x, sizeof(b));
+    return b;
+  }
+
+  static value_type from_bits(bits_type b) noexcept {
+    value_type x;
+    std::memcpy(&x, &b, sizeof(x));
+    return x;
+  }
+
+  // Monotonic map from value to the index of its bin among all bins of this precision.
+  // Negative values and NaN give arbitrary results, which index() sorts out.
+  std::uint64_t global_index(value_type x) const noexcept {
+    return detail::static_if<std::is_floating_point<value_type>>(
+        [this](auto x) -> std::uint64_t {
+          // positive floats compare like their bit patterns
+          constexpr unsigned mantissa = std::numeric_limits<value_type>::digits - 1;
+          return to_bits(x) >> (mantissa - bits_);
+        },
+        [this](auto x) -> std::uint64_t {
+          const auto u = static_cast<std::uint64_t>(x);
+          if (u < (std::uint64_t{1} << bits_)) return u;
+          const auto shift = detail::bit_width_minus_one(u) - bits_;
+          return (std::uint64_t{shift} << bits_) + (u >> shift);
+        },
+        x);
+  }
+
+  // Inverse of global_index, returns lower edge of bin.
+  real_value_type lower_edge(std::uint64_t k) const noexcept {
+    return detail::static_if<std::is_floating_point<value_type>>(
+        [this](auto k) -> real_value_type {
+          constexpr unsigned mantissa = std::numeric_limits<value_type>::digits - 1;
+          return from_bits(static_cast<bits_type>(k << (mantissa - bits_)));
+        },
+        [this](auto k) -> real_value_type {
+          if (k < (std::uint64_t{2} << bits_)) return static_cast<real_value_type>(k);
+          const auto shift = (k >> bits_) - 1;
+          return std::ldexp(static_cast<real_value_type>(k - (shift << bits_)),
+                            static_cast<int>(shift));
+        },
+        k);
+  }
+
+  detail::compressed_pair<index_type, metadata_type> size_meta_{0};
+  unsigned bits_{0};
+  std::uint64_t min_{0};
+
+  template <class V, class M, class O>
+  friend class log_linear;
+};
+
+#if __cpp_deduction_guides >= 201606
+
+template <class T>
+log_linear(unsigned, T, T)->log_linear<T>;
+
+template <class T>
+log_linear(unsigned, T, T, const char*)->log_linear<T>;
+
+template <class T, class M>
+log_linear(unsigned, T, T, M)->log_linear<T, M>;
+
+#endif
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -10,6 +10,7 @@
 #define BOOST_HISTOGRAM_AXIS_OSTREAM_HPP
 
 #include <boost/assert.hpp>
+#include <boost/histogram/axis/interned_string.hpp>
 #include <boost/histogram/axis/regular.hpp>
 #include <boost/histogram/detail/cat.hpp>
 #include <boost/histogram/detail/meta.hpp>
@@ -111,6 +112,12 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os, const null_
   return os; // do nothing
 }
 
+template <class... Ts>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const interned_string& s) {
+  return os << s.str();
+}
+
 template <class... Ts, class U>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const interval_view<U>& i) {
@@ -150,6 +157,39 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
   return os;
 }
 
+template <class... Ts, class... Us>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const log_linear<Us...>& a) {
+  os << "log_linear(" << a.size() << ", " << a.value(0) << ", " << a.value(a.size())
+     << ", bins_per_octave=" << a.bins_per_octave();
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
+template <class... Ts, unsigned B, std::intmax_t S, std::intmax_t E, class U, class M,
+          class O>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const static_regular<B, S, E, U, M, O>& a) {
+  os << "static_regular(" << a.size() << ", " << a.value(0) << ", "
+     << a.value(a.size());
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
+template <class... Ts, int S, int E, class M, class O>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const static_integer<S, E, M, O>& a) {
+  os << "static_integer(" << a.value(0) << ", " << a.value(a.size());
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
 template <class... Ts, class... Us>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const variable<Us...>& a) {
@@ -175,6 +215,21 @@ std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
   return os;
 }
 
+template <class... Ts, class... Us>
+std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
+                                      const top_k_category<Us...>& a) {
+  os << "top_k_category(";
+  for (index_type i = 0, n = a.size(); i < n; ++i) {
+    detail::stream_value(os, a.value(i));
+    os << ", ";
+  }
+  os << "k=" << a.k() << ", counters=" << a.counters() << ", min_count=" << a.min_count();
+  detail::stream_metadata(os, a.metadata());
+  detail::stream_options(os, a.options());
+  os << ")";
+  return os;
+}
+
 template <class... Ts, class... Us>
 std::basic_ostream<Ts...>& operator<<(std::basic_ostream<Ts...>& os,
                                       const variant<Us...>& v) {
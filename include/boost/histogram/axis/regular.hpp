@@ -7,16 +7,21 @@
 #ifndef BOOST_HISTOGRAM_AXIS_REGULAR_HPP
 #define BOOST_HISTOGRAM_AXIS_REGULAR_HPP
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/histogram/axis/interval_view.hpp>
 #include <boost/histogram/axis/iterator.hpp>
 #include <boost/histogram/axis/option.hpp>
 #include <boost/histogram/detail/compressed_pair.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/mp11/utility.hpp>
 #include <boost/throw_exception.hpp>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
@@ -24,6 +29,86 @@
 
 namespace boost {
 namespace histogram {
+namespace detail {
+
+// Approximation of log(x) with absolute error < 1e-6, NaN if x is not a positive
+// normal number. Has no branches or divisions, so compilers can vectorize loops over it.
+inline double fast_log(double x) noexcept {
+  constexpr std::uint64_t mantissa_mask = (std::uint64_t{1} << 52) - 1;
+  constexpr std::uint64_t sqrt2_mantissa = 0x6a09e667f3bcd;
+  std::uint64_t b;
+  std::memcpy(&b, &x, sizeof(b));
+  // x = 2^e * m with m in [sqrt(1/2), sqrt(2))
+  const std::uint64_t above = (b & mantissa_mask) >= sqrt2_mantissa;
+  const auto e = static_cast<int>((b >> 52) & 0x7ff) - 1023 + static_cast<int>(above);
+  const std::uint64_t mb = (b & mantissa_mask) | ((1023 - above) << 52);
+  double m;
+  std::memcpy(&m, &mb, sizeof(m));
+  // polynomial interpolation of log(1 + u) at Chebyshev nodes, error < 3e-7
+  const double u = m - 1;
+  double p = 0.11324218501791579;
+  p = p * u - 0.18732522000720894;
+  p = p * u + 0.20690039666692583;
+  p = p * u - 0.24902802756948272;
+  p = p * u + 0.33298299709538814;
+  p = p * u - 0.5000142842637965;
+  p = p * u + 1.0000042239200484;
+  p = p * u + 3.5902292882743744e-08;
+  const double r = e * 0.693147180559945309417 + p;
+  const bool valid = (b >> 52) - 1 < 0x7fe; // exponent not 0 or 0x7ff, sign not set
+  return valid ? r : std::numeric_limits<double>::quiet_NaN();
+}
+
+// Approximation of exp(x) with relative error < 1e-6, NaN if result is not a normal
+// number. Has no branches or divisions, so compilers can vectorize loops over it.
+inline double fast_exp(double x) noexcept {
+  constexpr double ln2 = 0.693147180559945309417;
+  const bool valid = x > -708 && x < 709; // also false if x is NaN
+  x = valid ? x : 0;
+  // exp(x) = 2^k exp(r) with |r| < ln2
+  const auto k = static_cast<int>(x * (1 / ln2));
+  const double r = x - k * ln2;
+  // polynomial interpolation of exp(r) at Chebyshev nodes, relative error < 6e-7
+  double p = 0.0014098815941157735;
+  p = p * r + 0.00850155551514045;
+  p = p * r + 0.04166161357609952;
+  p = p * r + 0.16662615426005042;
+  p = p * r + 0.5000003036736137;
+  p = p * r + 1.0000024350614478;
+  p = p * r + 1;
+  const auto b = static_cast<std::uint64_t>(k + 1023) << 52;
+  double f;
+  std::memcpy(&f, &b, sizeof(f));
+  return valid ? p * f : std::numeric_limits<double>::quiet_NaN();
+}
+
+// Computes index i of t = (x - min) * n / (max - min) for n bins. Multiplication with
+// n / (max - min) is faster than division by (max - min), but may round differently.
+// The bound on the difference is a few epsilon relative to n, plus err. If t is not
+// closer to a bin edge than that, i is set to the index which the division gives and
+// true is returned, otherwise the caller must compute it by division.
+template <class T>
+bool scaled_index(T t, axis::index_type n, T err, axis::index_type& i) noexcept {
+  const auto tol = 4 * std::numeric_limits<T>::epsilon() * n + err;
+  // bitwise and gives fewer branches
+  if ((t >= 0) & (t < n)) {
+    i = static_cast<axis::index_type>(t);
+    const auto f = t - i;
+    return (f > tol) & (f < 1 - tol);
+  }
+  if (t <= -tol) {
+    i = -1;
+    return true;
+  }
+  if (t >= n + tol) {
+    i = n;
+    return true;
+  }
+  return false; // also returned if t is NaN
+}
+
+} // namespace detail
+
 namespace axis {
 
 namespace transform {
@@ -56,6 +141,12 @@ struct log {
   static T inverse(T x) {
     return std::exp(x);
   }
+
+  /// Returns approximation of log(x) without calls into libm, see fast_forward_error().
+  static double fast_forward(double x) noexcept { return detail::fast_log(x); }
+
+  /// Returns e so that |fast_forward(x) - forward(x)| < e (1 + |forward(x)|).
+  static constexpr double fast_forward_error() noexcept { return 1e-6; }
 };
 
 /// Sqrt transform for equidistant bins in sqrt-space.
@@ -93,6 +184,14 @@ struct pow {
     return std::pow(x, 1.0 / power);
   }
 
+  /// Returns approximation of pow(x, power) without calls into libm.
+  double fast_forward(double x) const noexcept {
+    return detail::fast_exp(power * detail::fast_log(x));
+  }
+
+  /// Returns e so that |fast_forward(x) - forward(x)| < e (1 + |forward(x)|).
+  double fast_forward_error() const noexcept { return 1e-6 * (1 + std::abs(power)); }
+
   bool operator==(const pow& o) const noexcept { return power == o.power; }
 };
 
@@ -161,6 +260,7 @@ public:
           std::invalid_argument("forward transform of start or stop invalid"));
     if (delta_ == 0)
       BOOST_THROW_EXCEPTION(std::invalid_argument("range of axis is zero"));
+    update_scale();
   }
 
   /** Construct n bins over real range [start, stop).
@@ -226,7 +326,12 @@ public:
   /// Return index for value argument.
   index_type index(value_type x) const noexcept {
     // Runs in hot loop, please measure impact of changes
-    auto z = (this->forward(x / unit_type{}) - min_) / delta_;
+    const auto d = this->forward(x / unit_type{}) - min_;
+    if (!options_type::test(option::circular)) {
+      index_type i;
+      if (detail::scaled_index(d * scale_, size(), internal_value_type{0}, i)) return i;
+    }
+    auto z = d / delta_;
     if (options_type::test(option::circular)) {
       if (std::isfinite(z)) {
         z -= std::floor(z);
@@ -243,10 +348,44 @@ public:
     return size(); // also returned if x is NaN
   }
 
+  /** Compute indices for n values, for example, from a column of values.
+   *
+   * Gives the same result as calling index() for each value. It is only faster for the
+   * log and pow transforms, because it first computes cheap approximations of the
+   * transform in a loop that compilers can vectorize. The exact transform is only
+   * computed for values too close to a bin edge. For other transforms and for circular
+   * axes, it calls index() for each value.
+   */
+  void index_n(const value_type* x, std::size_t n, index_type* out) const noexcept {
+    if (options_type::test(option::circular) ||
+        !detail::has_fast_forward<transform_type>::value) {
+      for (std::size_t k = 0; k < n; ++k) out[k] = index(x[k]);
+      return;
+    }
+    constexpr std::size_t chunk = 128;
+    internal_value_type f[chunk];
+    while (n > 0) {
+      const auto m = std::min(n, chunk);
+      for (std::size_t k = 0; k < m; ++k) f[k] = approx_forward(x[k]);
+      for (std::size_t k = 0; k < m; ++k)
+        if (!detail::scaled_index((f[k] - min_) * scale_, size(), approx_error(f[k]),
+                                  out[k]))
+          out[k] = index(x[k]);
+      x += m;
+      out += m;
+      n -= m;
+    }
+  }
+
   /// Returns index and shift (if axis has grown) for the passed argument.
   auto update(value_type x) noexcept {
     BOOST_ASSERT(options_type::test(option::growth));
-    const auto z = (this->forward(x / unit_type{}) - min_) / delta_;
+    const auto d = this->forward(x / unit_type{}) - min_;
+    index_type j;
+    if (detail::scaled_index(d * scale_, size(), internal_value_type{0}, j) && j >= 0 &&
+        j < size())
+      return std::make_pair(j, 0);
+    const auto z = d / delta_;
     if (z < 1) { // don't use i here!
       if (z >= 0) {
         const auto i = static_cast<axis::index_type>(z * size());
@@ -258,6 +397,7 @@ public:
         min_ += i * (delta_ / size());
         delta_ = stop - min_;
         size_meta_.first() -= i;
+        update_scale();
         return std::make_pair(0, -i);
       }
       // z is -infinity
@@ -270,6 +410,7 @@ public:
       delta_ /= size();
       delta_ *= size() + n;
       size_meta_.first() += n;
+      update_scale();
       return std::make_pair(i, -n);
     }
     // z either infinite or NaN
@@ -318,8 +459,41 @@ public:
   void serialize(Archive&, unsigned);
 
 private:
+  // Returns forward transform of x or, if the transform has one, its approximation.
+  internal_value_type approx_forward(value_type x) const noexcept {
+    return detail::static_if<detail::has_fast_forward<transform_type>>(
+        [](const auto& tr, auto x) {
+          return static_cast<internal_value_type>(
+              tr.fast_forward(static_cast<double>(x / unit_type{})));
+        },
+        [](const auto& tr, auto x) {
+          return static_cast<internal_value_type>(tr.forward(x / unit_type{}));
+        },
+        transform(), x);
+  }
+
+  // Returns bound for the difference between approx_forward and forward in bins.
+  internal_value_type approx_error(internal_value_type f) const noexcept {
+    return detail::static_if<detail::has_fast_forward<transform_type>>(
+        [this](const auto& tr, auto f) {
+          const auto e = tr.fast_forward_error() +
+                         std::numeric_limits<internal_value_type>::epsilon();
+          return static_cast<internal_value_type>(e * (1 + std::abs(f)) *
+                                                  std::abs(scale_));
+        },
+        [](const auto&, auto) { return internal_value_type{0}; }, transform(), f);
+  }
+
+  // Tiny ranges may overflow the scale, then NaN makes scaled_index always fail and
+  // index() falls back to the division.
+  void update_scale() noexcept {
+    scale_ = size() / delta_;
+    if (!std::isfinite(scale_))
+      scale_ = std::numeric_limits<internal_value_type>::quiet_NaN();
+  }
+
   detail::compressed_pair<index_type, metadata_type> size_meta_{0};
-  internal_value_type min_{0}, delta_{1};
+  internal_value_type min_{0}, delta_{1}, scale_{0};
 
   template <class V, class T, class M, class O>
   friend class regular;
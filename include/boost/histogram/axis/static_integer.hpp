@@ -0,0 +1,100 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_STATIC_INTEGER_HPP
+#define BOOST_HISTOGRAM_AXIS_STATIC_INTEGER_HPP
+
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+
+/**
+  Axis for an interval of integer values with unit steps and compile-time range.
+
+  Like an integer axis for int values, but the range is given by template arguments. The
+  axis stores only the metadata and size() is known at compile-time. A histogram with
+  only such axes can therefore compute strides and the number of cells at compile-time,
+  see make_static_histogram.
+
+  @tparam Start first integer of covered range.
+  @tparam Stop one past last integer of covered range.
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (circular and growth not allowed).
+ */
+template <int Start, int Stop, class MetaData, class Options>
+class static_integer
+    : public iterator_mixin<static_integer<Start, Stop, MetaData, Options>> {
+  static_assert(Start < Stop, "start < stop required");
+
+  using value_type = int;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(!options_type::test(option::circular) &&
+                    !options_type::test(option::growth),
+                "static_integer axis does not support circular or growth options");
+
+public:
+  constexpr static_integer() = default;
+
+  /// Construct axis with metadata.
+  explicit static_integer(metadata_type meta) : meta_(std::move(meta)) {}
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    const auto z = x - Start;
+    if (z < size()) return z >= 0 ? z : -1;
+    return size();
+  }
+
+  /// Return value for index argument.
+  value_type value(index_type i) const noexcept {
+    if (i < 0) return detail::lowest<value_type>();
+    if (i > size()) return detail::highest<value_type>();
+    return Start + i;
+  }
+
+  /// Return bin for index argument.
+  value_type bin(index_type idx) const noexcept { return value(idx); }
+
+  /// Returns the number of bins, without over- or underflow.
+  static constexpr index_type size() noexcept { return Stop - Start; }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return meta_; }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return meta_; }
+
+  template <int S, int E, class M, class O>
+  bool operator==(const static_integer<S, E, M, O>& o) const noexcept {
+    return Start == S && Stop == E && detail::relaxed_equal(metadata(), o.metadata());
+  }
+  template <int S, int E, class M, class O>
+  bool operator!=(const static_integer<S, E, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  metadata_type meta_;
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+#define BOOST_HISTOGRAM_AXIS_STATIC_REGULAR_HPP
+
+#include <boost/histogram/axis/interval_view.hpp>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/axis/regular.hpp> // detail::scaled_index
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+
+/**
+  Axis for equidistant intervals on the real line with compile-time binning.
+
+  Like a regular axis without transform, but number of bins and range are template
+  arguments. The axis stores only the metadata, and size(), the bin edges, and the
+  constants used by index() are known at compile-time. A histogram with only such axes
+  can therefore compute strides and the number of cells at compile-time, see
+  make_static_histogram.
+
+  The range is [Start * Unit, Stop * Unit). Non-integral edges are expressed with the
+  std::ratio Unit, for example, static_regular<10, -5, 5, std::ratio<1, 10>> has 10 bins
+  from -0.5 to 0.5. The axis computes the same indices as a regular axis with the same
+  bins.
+
+  @tparam Bins number of bins.
+  @tparam Start low edge of first bin in units of Unit.
+  @tparam Stop high edge of last bin in units of Unit.
+  @tparam Unit std::ratio which is the unit of Start and Stop (default: std::ratio<1>).
+  @tparam MetaData type to store meta data.
+  @tparam Options see boost::histogram::axis::option (circular and growth not allowed).
+ */
+template <unsigned Bins, std::intmax_t Start, std::intmax_t Stop, class Unit,
+          class MetaData, class Options>
+class static_regular
+    : public iterator_mixin<static_regular<Bins, Start, Stop, Unit, MetaData, Options>> {
+  static_assert(Bins > 0, "bins > 0 required");
+  static_assert(Start < Stop, "start < stop required");
+
+  using value_type = double;
+  using unit_type = detail::replace_default<Unit, std::ratio<1>>;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type =
+      detail::replace_default<Options, decltype(option::underflow | option::overflow)>;
+
+  static_assert(!options_type::test(option::circular) &&
+                    !options_type::test(option::growth),
+                "static_regular axis does not support circular or growth options");
+
+public:
+  constexpr static_regular() = default;
+
+  /// Construct axis with metadata.
+  explicit static_regular(metadata_type meta) : meta_(std::move(meta)) {}
+
+  /// Return index for value argument.
+  index_type index(value_type x) const noexcept {
+    // Runs in hot loop, please measure impact of changes
+    const auto d = x - min();
+    index_type i;
+    if (detail::scaled_index(d * scale(), size(), value_type{0}, i)) return i;
+    const auto z = d / delta();
+    if (z < 1) {
+      if (z >= 0)
+        return static_cast<index_type>(z * size());
+      else
+        return -1;
+    }
+    return size(); // also returned if x is NaN
+  }
+
+  /// Return value for fractional index argument.
+  value_type value(real_index_type i) const noexcept {
+    const auto z = i / size();
+    if (z < 0.0) return -std::numeric_limits<value_type>::infinity();
+    if (z <= 1.0) return (1.0 - z) * min() + z * (min() + delta());
+    return std::numeric_limits<value_type>::infinity();
+  }
+
+  /// Return bin for index argument.
+  decltype(auto) bin(index_type idx) const noexcept {
+    return interval_view<static_regular>(*this, idx);
+  }
+
+  /// Returns the number of bins, without over- or underflow.
+  static constexpr index_type size() noexcept { return static_cast<index_type>(Bins); }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return meta_; }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return meta_; }
+
+  template <unsigned B, std::intmax_t S, std::intmax_t E, class U, class M, class O>
+  bool operator==(const static_regular<B, S, E, U, M, O>& o) const noexcept {
+    return size() == o.size() && min() == o.min() && delta() == o.delta() &&
+           detail::relaxed_equal(metadata(), o.metadata());
+  }
+  template <unsigned B, std::intmax_t S, std::intmax_t E, class U, class M, class O>
+  bool operator!=(const static_regular<B, S, E, U, M, O>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  static constexpr value_type min() noexcept {
+    return static_cast<value_type>(Start) * unit_type::num / unit_type::den;
+  }
+  static constexpr value_type delta() noexcept {
+    return static_cast<value_type>(Stop) * unit_type::num / unit_type::den - min();
+  }
+  static constexpr value_type scale() noexcept { return size() / delta(); }
+
+  metadata_type meta_;
+
+  template <unsigned B, std::intmax_t S, std::intmax_t E, class U, class M, class O>
+  friend class static_regular;
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
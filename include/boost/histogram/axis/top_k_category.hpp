@@ -0,0 +1,170 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_AXIS_TOP_K_CATEGORY_HPP
+#define BOOST_HISTOGRAM_AXIS_TOP_K_CATEGORY_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/iterator.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace axis {
+
+/**
+  Category axis which keeps bins only for the most frequent values.
+
+  The axis grows like a category axis with growth option, but has at most k bins.
+  Values which are not frequent enough to get a bin are counted in the overflow bin.
+  Candidates for new bins are found with the Misra-Gries algorithm: a table with a fixed
+  number of counters tracks the values which are not yet bins. A counter of a value is
+  a lower bound for the number of times the value occurred since it entered the table.
+  When the counter reaches min_count, the value gets the next free bin and is removed
+  from the table. Since a counter underestimates the occurrences by at most
+  n / (counters + 1) in n fills, a value is only guaranteed to get a bin if it occurs more
+  often than min_count + n / (counters + 1) times, and if a bin is still free.
+
+  Bins are never removed or reordered, so the bin of a value stays the same once it was
+  assigned. Fills of a value before it gets a bin remain in the overflow bin. Memory is
+  bounded by k bins plus the counter table, which is released when all bins are used.
+  Lookup of a value is a hash table lookup, the value type must be hashable.
+
+  @tparam Value input value type, must be equal-comparable and hashable.
+  @tparam MetaData type to store meta data.
+ */
+template <class Value, class MetaData>
+class top_k_category : public iterator_mixin<top_k_category<Value, MetaData>> {
+  using value_type = Value;
+  using metadata_type = detail::replace_default<MetaData, std::string>;
+  using options_type = decltype(option::overflow | option::growth);
+
+public:
+  top_k_category() = default;
+
+  /** Construct empty axis with a memory budget.
+   *
+   * \param k          maximum number of bins.
+   * \param counters   number of counters for values which are not yet bins.
+   * \param min_count  counter value at which a value gets a bin.
+   * \param meta       description of the axis (optional).
+   */
+  top_k_category(index_type k, unsigned counters, unsigned min_count,
+                 metadata_type meta = {})
+      : meta_(std::move(meta)), k_(k), counters_(counters), min_count_(min_count) {
+    if (k <= 0) BOOST_THROW_EXCEPTION(std::invalid_argument("k > 0 required"));
+    if (counters == 0)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("counters > 0 required"));
+    if (min_count == 0)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("min_count > 0 required"));
+  }
+
+  /// Return index for value argument.
+  index_type index(const value_type& x) const {
+    const auto it = lookup_.find(x);
+    return it != lookup_.end() ? it->second : size();
+  }
+
+  /// Returns index and shift (if axis has grown) for the passed argument.
+  std::pair<index_type, index_type> update(const value_type& x) {
+    const auto i = index(x);
+    if (i < size() || size() == k_ || !count(x)) return std::make_pair(i, 0);
+    lookup_.emplace(x, i);
+    seq_.push_back(x);
+    if (size() == k_) decltype(table_)().swap(table_);
+    return std::make_pair(i, -1);
+  }
+
+  /// Return value for index argument.
+  /// Throws `std::out_of_range` if the index is out of bounds.
+  const value_type& value(index_type idx) const {
+    if (idx < 0 || idx >= size())
+      BOOST_THROW_EXCEPTION(std::out_of_range("category index out of range"));
+    return seq_[idx];
+  }
+
+  /// Return value for index argument.
+  const value_type& bin(index_type idx) const { return value(idx); }
+
+  /// Returns the number of bins, without overflow.
+  index_type size() const noexcept { return static_cast<index_type>(seq_.size()); }
+  /// Returns maximum number of bins.
+  index_type k() const noexcept { return k_; }
+  /// Returns number of counters for values which are not yet bins.
+  unsigned counters() const noexcept { return counters_; }
+  /// Returns counter value at which a value gets a bin.
+  unsigned min_count() const noexcept { return min_count_; }
+  /// Returns the options.
+  static constexpr unsigned options() noexcept { return options_type::value; }
+  /// Returns reference to metadata.
+  metadata_type& metadata() noexcept { return meta_; }
+  /// Returns reference to const metadata.
+  const metadata_type& metadata() const noexcept { return meta_; }
+
+  template <class V, class M>
+  bool operator==(const top_k_category<V, M>& o) const noexcept {
+    return k_ == o.k_ && counters_ == o.counters_ && min_count_ == o.min_count_ &&
+           std::equal(seq_.begin(), seq_.end(), o.seq_.begin(), o.seq_.end()) &&
+           detail::relaxed_equal(metadata(), o.metadata());
+  }
+
+  template <class V, class M>
+  bool operator!=(const top_k_category<V, M>& o) const noexcept {
+    return !operator==(o);
+  }
+
+  template <class Archive>
+  void serialize(Archive&, unsigned);
+
+private:
+  // Misra-Gries step, returns true if x should get a bin
+  bool count(const value_type& x) {
+    const auto it = table_.find(x);
+    if (it != table_.end()) {
+      if (++it->second < min_count_) return false;
+      table_.erase(it);
+      return true;
+    }
+    if (table_.size() < counters_) {
+      if (min_count_ == 1) return true;
+      table_.emplace(x, 1u);
+      return false;
+    }
+    // table is full: decrement all counters, amortized O(1) per call
+    for (auto it2 = table_.begin(); it2 != table_.end();) {
+      if (--it2->second == 0)
+        it2 = table_.erase(it2);
+      else
+        ++it2;
+    }
+    return false;
+  }
+
+  metadata_type meta_;
+  index_type k_ = 0;
+  unsigned counters_ = 0;
+  unsigned min_count_ = 0;
+  std::vector<value_type> seq_;
+  std::unordered_map<value_type, index_type> lookup_;
+  std::unordered_map<value_type, unsigned> table_;
+
+  template <class V, class M>
+  friend class top_k_category;
+};
+
+} // namespace axis
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,1262 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_BINARY_HPP
+#define BOOST_HISTOGRAM_BINARY_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/crc32.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/parallel_for.hpp>
+#include <boost/histogram/detail/pipeline.hpp>
+#include <boost/histogram/execution.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/span_storage.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/tracking_storage.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/tuple.hpp>
+#include <boost/mp11/utility.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+  \file boost/histogram/binary.hpp
+
+  Native binary format for histograms.
+
+  The format consists of a fixed-size header, a section with the axes, and a storage
+  block which starts at an offset that is a multiple of 64 bytes. Storages with trivially
+  copyable cells in contiguous memory, like dense_storage and unlimited_storage, are
+  written as a raw image of the cell array. Such a block is read with a single copy, or
+  can be used in place if the data is memory-mapped, see read_binary_info().
+
+  Numbers are written in the byte order of the machine, the header contains a byte order
+  mark and data written on a machine with a different byte order is rejected. The axes
+  and cell types of the histogram which is loaded must match those of the saved
+  histogram.
+
+  For histograms with tracking_storage, save_delta() writes only the blocks of cells
+  which were modified after a checkpoint, and apply_delta() writes them into another
+  histogram with the same axes.
+
+  The axes and accumulators are encoded with their serialize() member functions, so this
+  header includes the header-only parts of Boost.Serialization, but no Boost.Serialization
+  archive is used and no library needs to be linked.
+*/
+
+namespace boost {
+namespace histogram {
+
+/// Layout of the storage block in the binary format.
+enum class binary_encoding : std::uint32_t {
+  raw = 0,      ///< contiguous array of cells, each cell value_size bytes
+  elements = 1, ///< cells encoded one after another with their serialize() method
+  sparse = 2,   ///< number of non-empty cells, followed by pairs of index and cell
+  packed = 3,   ///< runs of zero and non-zero counts, counts are varint-encoded deltas
+};
+
+/// Type of storage saved in the binary format.
+enum class binary_storage : std::uint32_t {
+  dense = 0,     ///< storage_adaptor over a std::vector or std::array
+  map = 1,       ///< storage_adaptor over a std::map or std::unordered_map
+  unlimited = 2, ///< unlimited_storage
+  other = 3,     ///< any other storage
+};
+
+/// Decoded header of a histogram in binary format, see read_binary_info().
+struct binary_info {
+  std::uint32_t version = 0;    ///< format version
+  std::uint32_t rank = 0;       ///< number of axes
+  binary_storage storage_type{}; ///< type of storage
+  binary_encoding encoding{};   ///< layout of storage block
+  std::uint32_t value_size = 0; ///< size of one cell for binary_encoding::raw
+  std::uint32_t tier = 0;       ///< index of the cell type of unlimited_storage
+  std::uint64_t cells = 0;      ///< number of cells
+  const void* axes = nullptr;   ///< pointer to the axes section
+  std::size_t axes_size = 0;    ///< size of the axes section in bytes
+  const void* block = nullptr;  ///< pointer to storage block
+  std::size_t block_size = 0;   ///< size of storage block in bytes, without chunk headers
+  bool chunked = false;         ///< storage block is split into chunks with checksums
+};
+
+namespace detail {
+
+constexpr char binary_magic[8] = {'B', 'H', 'I', 'S', 'T', 'B', 'I', 'N'};
+constexpr std::uint32_t binary_version = 1;
+constexpr std::uint32_t binary_byte_order_mark = 0x01020304;
+constexpr std::size_t binary_header_size = 72;
+constexpr std::size_t binary_alignment = 64;
+constexpr std::uint32_t binary_flag_chunked = 1;
+constexpr std::size_t binary_chunk_header_size = 8;
+constexpr std::size_t binary_max_chunk_size = std::size_t{1} << 30;
+
+inline std::size_t binary_align(std::size_t n) noexcept {
+  return (n + binary_alignment - 1) / binary_alignment * binary_alignment;
+}
+
+// Reads n bytes into s. Sizes come from the data, so s grows in steps only as far as
+// bytes arrive, a corrupt size cannot trigger a huge allocation.
+inline void binary_read(std::istream& is, std::string& s, std::size_t n) {
+  constexpr std::size_t step = std::size_t{1} << 20;
+  s.clear();
+  while (s.size() < n) {
+    const auto k = std::min(n - s.size(), step);
+    s.resize(s.size() + k);
+    if (!is.read(&s[s.size() - k], static_cast<std::streamsize>(k)))
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  }
+}
+
+template <class T, class Archive>
+using serialize_member_t =
+    decltype(std::declval<T&>().serialize(std::declval<Archive&>(), 0u));
+
+// Writes objects into a string. Implements the subset of the Boost.Serialization
+// archive interface which is used by the serialize functions of this library.
+class binary_oarchive {
+public:
+  using is_loading = std::false_type;
+  using is_saving = std::true_type;
+
+  explicit binary_oarchive(std::string& buf) : buf_(buf) {}
+
+  template <class T>
+  binary_oarchive& operator&(const serialization::nvp<T>& x) {
+    save(x.const_value());
+    return *this;
+  }
+
+  template <class T>
+  binary_oarchive& operator<<(const serialization::nvp<T>& x) {
+    return operator&(x);
+  }
+
+  void save_bytes(const void* p, std::size_t n) {
+    buf_.append(static_cast<const char*>(p), n);
+  }
+
+  template <class T>
+  std::enable_if_t<(std::is_arithmetic<T>::value || std::is_enum<T>::value)> save(
+      const T& x) {
+    save_bytes(&x, sizeof(T));
+  }
+
+  // LEB128 encoding, small numbers use fewer bytes
+  void save_varint(std::uint64_t x) {
+    for (; x >= 0x80; x >>= 7) buf_.push_back(static_cast<char>((x & 0x7f) | 0x80));
+    buf_.push_back(static_cast<char>(x));
+  }
+
+  template <class C, class Tr, class A>
+  void save(const std::basic_string<C, Tr, A>& s) {
+    save(static_cast<std::uint64_t>(s.size()));
+    save_bytes(s.data(), s.size() * sizeof(C));
+  }
+
+  template <class T, class A>
+  void save(const std::vector<T, A>& v) {
+    save(static_cast<std::uint64_t>(v.size()));
+    save_sequence(std::is_arithmetic<T>{}, v);
+  }
+
+  template <class... Ts>
+  void save(const std::tuple<Ts...>& t) {
+    mp11::tuple_for_each(t, [this](const auto& x) { this->save(x); });
+  }
+
+  template <class... Ts>
+  void save(const axis::variant<Ts...>& v) {
+    axis::visit(
+        [this](const auto& x) {
+          using T = remove_cvref_t<decltype(x)>;
+          using which = mp11::mp_find<mp11::mp_list<Ts...>, T>;
+          this->save(static_cast<std::int32_t>(which::value));
+          this->save(x);
+        },
+        v);
+  }
+
+  template <class T>
+  std::enable_if_t<std::is_class<T>::value> save(const T& x) {
+    // Boost.Serialization uses the same serialize() for saving and loading
+    save_class(mp11::mp_valid<serialize_member_t, T, binary_oarchive>{},
+               const_cast<T&>(x));
+  }
+
+private:
+  template <class V>
+  void save_sequence(std::true_type, const V& v) {
+    save_bytes(v.data(), v.size() * sizeof(typename V::value_type));
+  }
+
+  template <class V>
+  void save_sequence(std::false_type, const V& v) {
+    for (const auto& x : v) save(x);
+  }
+
+  template <class T>
+  void save_class(std::true_type, T& x) {
+    x.serialize(*this, 0);
+  }
+
+  template <class T>
+  void save_class(std::false_type, T& x) {
+    serialize(*this, x, 0u);
+  }
+
+  std::string& buf_;
+};
+
+// Reads objects from a range of bytes, the counterpart of binary_oarchive.
+class binary_iarchive {
+public:
+  using is_loading = std::true_type;
+  using is_saving = std::false_type;
+
+  binary_iarchive(const char* begin, const char* end) : ptr_(begin), end_(end) {}
+
+  template <class T>
+  binary_iarchive& operator&(const serialization::nvp<T>& x) {
+    load(x.value());
+    return *this;
+  }
+
+  template <class T>
+  binary_iarchive& operator>>(const serialization::nvp<T>& x) {
+    return operator&(x);
+  }
+
+  std::size_t remaining() const noexcept { return static_cast<std::size_t>(end_ - ptr_); }
+
+  const char* position() const noexcept { return ptr_; }
+
+  void load_bytes(void* p, std::size_t n) {
+    if (n > remaining())
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    if (n > 0) std::memcpy(p, ptr_, n);
+    ptr_ += n;
+  }
+
+  template <class T>
+  std::enable_if_t<(std::is_arithmetic<T>::value || std::is_enum<T>::value)> load(
+      T& x) {
+    load_bytes(&x, sizeof(T));
+  }
+
+  std::uint64_t load_varint() {
+    std::uint64_t x = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (ptr_ == end_)
+        BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+      const auto byte = static_cast<unsigned char>(*ptr_++);
+      x |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return x;
+    }
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid number in binary data"));
+  }
+
+  template <class C, class Tr, class A>
+  void load(std::basic_string<C, Tr, A>& s) {
+    s.resize(load_size(sizeof(C)));
+    load_bytes(&s[0], s.size() * sizeof(C));
+  }
+
+  template <class T, class A>
+  void load(std::vector<T, A>& v) {
+    v.resize(load_size(std::is_arithmetic<T>::value ? sizeof(T) : 1));
+    load_sequence(std::is_arithmetic<T>{}, v);
+  }
+
+  template <class... Ts>
+  void load(std::tuple<Ts...>& t) {
+    mp11::tuple_for_each(t, [this](auto& x) { this->load(x); });
+  }
+
+  template <class... Ts>
+  void load(axis::variant<Ts...>& v) {
+    std::int32_t which = 0;
+    load(which);
+    constexpr unsigned N = sizeof...(Ts);
+    if (which < 0 || static_cast<unsigned>(which) >= N)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid axis type in binary data"));
+    mp11::mp_with_index<N>(static_cast<unsigned>(which), [this, &v](auto i) {
+      mp11::mp_at_c<mp11::mp_list<Ts...>, i> x;
+      this->load(x);
+      v = std::move(x);
+    });
+  }
+
+  template <class T>
+  std::enable_if_t<std::is_class<T>::value> load(T& x) {
+    load_class(mp11::mp_valid<serialize_member_t, T, binary_iarchive>{}, x);
+  }
+
+private:
+  // reads size of a sequence and checks that enough data is left for its elements
+  std::size_t load_size(std::size_t min_element_size) {
+    std::uint64_t n = 0;
+    load(n);
+    if (n > remaining() / min_element_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    return static_cast<std::size_t>(n);
+  }
+
+  template <class V>
+  void load_sequence(std::true_type, V& v) {
+    load_bytes(v.data(), v.size() * sizeof(typename V::value_type));
+  }
+
+  template <class V>
+  void load_sequence(std::false_type, V& v) {
+    for (auto& x : v) load(x);
+  }
+
+  template <class T>
+  void load_class(std::true_type, T& x) {
+    x.serialize(*this, 0);
+  }
+
+  template <class T>
+  void load_class(std::false_type, T& x) {
+    serialize(*this, x, 0u);
+  }
+
+  const char* ptr_;
+  const char* end_;
+};
+
+// Description of the storage block, filled by save_storage. If raw is not null, it
+// points to the cell array, otherwise the encoded block is in the buffer.
+struct binary_block {
+  binary_info info;
+  const void* raw = nullptr;
+  std::string buffer;
+  bool pack = false; // use binary_encoding::packed if the storage supports it
+};
+
+template <class S>
+void save_storage(const S& s, binary_block& b) {
+  b.info.storage_type = binary_storage::other;
+  b.info.encoding = binary_encoding::elements;
+  b.info.cells = s.size();
+  binary_oarchive ar(b.buffer);
+  for (auto&& x : s) {
+    const typename S::value_type v = x;
+    ar.save(v);
+  }
+}
+
+template <class T>
+void save_adaptor(std::false_type, const storage_adaptor<T>& s, binary_block& b) {
+  using V = typename T::value_type;
+  b.info.storage_type = binary_storage::dense;
+  b.info.cells = s.size();
+  if (std::is_trivially_copyable<V>::value) {
+    b.info.encoding = binary_encoding::raw;
+    b.info.value_size = sizeof(V);
+    b.raw = s.size() ? &*s.begin() : nullptr;
+  } else {
+    b.info.encoding = binary_encoding::elements;
+    binary_oarchive ar(b.buffer);
+    for (auto&& x : s) ar.save(x);
+  }
+}
+
+template <class T>
+void save_adaptor(std::true_type, const storage_adaptor<T>& s, binary_block& b) {
+  b.info.storage_type = binary_storage::map;
+  b.info.encoding = binary_encoding::sparse;
+  b.info.cells = s.size();
+  auto& impl = unsafe_access::storage_adaptor_impl(const_cast<storage_adaptor<T>&>(s));
+  const auto& map = static_cast<const T&>(impl);
+  binary_oarchive ar(b.buffer);
+  ar.save(static_cast<std::uint64_t>(map.size()));
+  for (auto&& kv : map) {
+    ar.save(static_cast<std::uint64_t>(kv.first));
+    ar.save(kv.second);
+  }
+}
+
+template <class T>
+void save_storage(const storage_adaptor<T>& s, binary_block& b) {
+  save_adaptor(is_map_like<T>{}, s, b);
+}
+
+inline std::uint64_t zigzag_encode(std::uint64_t x) noexcept {
+  return (x << 1) ^ (0 - (x >> 63));
+}
+
+inline std::uint64_t zigzag_decode(std::uint64_t x) noexcept {
+  return (x >> 1) ^ (0 - (x & 1));
+}
+
+// Writes alternating runs of zero and non-zero cells. A record consists of the number
+// of zero cells, the number of non-zero cells, and the differences between consecutive
+// non-zero cells. Neighboring cells usually have similar counts, so the differences are
+// small and fit into one or two bytes.
+template <class T>
+void pack_cells(const T* p, std::size_t n, std::string& out) {
+  binary_oarchive ar(out);
+  std::uint64_t prev = 0;
+  std::size_t i = 0;
+  while (i < n) {
+    const auto zeros = i;
+    while (i < n && p[i] == 0) ++i;
+    const auto first = i;
+    while (i < n && p[i] != 0) ++i;
+    ar.save_varint(first - zeros);
+    ar.save_varint(i - first);
+    for (auto k = first; k < i; ++k) {
+      const auto x = static_cast<std::uint64_t>(p[k]);
+      ar.save_varint(zigzag_encode(x - prev));
+      prev = x;
+    }
+  }
+}
+
+// p must point to n zero-initialized cells
+template <class T>
+void unpack_cells(binary_iarchive& ar, T* p, std::size_t n) {
+  std::uint64_t prev = 0;
+  std::size_t i = 0;
+  while (i < n) {
+    const auto zeros = ar.load_varint();
+    if (zeros > n - i)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell index in binary data"));
+    i += static_cast<std::size_t>(zeros);
+    const auto count = ar.load_varint();
+    if (count > n - i)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell index in binary data"));
+    for (const auto end = i + static_cast<std::size_t>(count); i < end; ++i) {
+      prev += zigzag_decode(ar.load_varint());
+      if (prev > std::numeric_limits<T>::max())
+        BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell value in binary data"));
+      p[i] = static_cast<T>(prev);
+    }
+  }
+}
+
+// Packs cells of an integral tier and stores the narrowest tier which can hold the
+// largest count, so that a storage which was grown by a few large values and then
+// reset is not restored at the wider tier.
+template <class Buffer, class T>
+void pack_buffer(std::true_type, const Buffer&, const T* p, std::size_t n,
+                 binary_block& b) {
+  const auto m = n ? *std::max_element(p, p + n) : T{0};
+  b.info.encoding = binary_encoding::packed;
+  b.info.value_size = 0;
+  if (m <= std::numeric_limits<std::uint8_t>::max())
+    b.info.tier = Buffer::template type_index<std::uint8_t>();
+  else if (m <= std::numeric_limits<std::uint16_t>::max())
+    b.info.tier = Buffer::template type_index<std::uint16_t>();
+  else if (m <= std::numeric_limits<std::uint32_t>::max())
+    b.info.tier = Buffer::template type_index<std::uint32_t>();
+  pack_cells(p, n, b.buffer);
+}
+
+template <class Buffer, class T>
+void pack_buffer(std::false_type, const Buffer&, const T* p, std::size_t,
+                 binary_block& b) {
+  b.info.encoding = binary_encoding::raw;
+  b.info.value_size = sizeof(T);
+  b.raw = p;
+}
+
+template <class A>
+void save_storage(const unlimited_storage<A>& s, binary_block& b) {
+  using large_int = typename unlimited_storage<A>::large_int;
+  const auto& buffer = unsafe_access::unlimited_storage_buffer(s);
+  b.info.storage_type = binary_storage::unlimited;
+  b.info.cells = buffer.size;
+  b.info.tier = buffer.type;
+  buffer.visit([&b, &buffer](const auto* tp) {
+    using T = remove_cvref_t<decltype(*tp)>;
+    if (std::is_same<T, large_int>::value) {
+      b.info.encoding = binary_encoding::elements;
+      binary_oarchive ar(b.buffer);
+      for (std::size_t i = 0; i < buffer.size; ++i) ar.save(tp[i]);
+    } else if (b.pack) {
+      pack_buffer(std::is_integral<T>{}, buffer, tp, buffer.size, b);
+    } else {
+      pack_buffer(std::false_type{}, buffer, tp, buffer.size, b);
+    }
+  });
+}
+
+inline void check_block(const binary_info& info, binary_storage type) {
+  if (info.storage_type != type)
+    BOOST_THROW_EXCEPTION(std::runtime_error("storage type in binary data differs"));
+}
+
+// Source of the storage block, read_raw copies raw bytes, elements returns an archive
+// for encoded blocks.
+template <class Source, class S>
+void load_storage(Source& src, const binary_info& info, S& s) {
+  check_block(info, binary_storage::other);
+  s.reset(info.cells);
+  auto ar = src.elements();
+  for (std::size_t i = 0; i < info.cells; ++i) {
+    typename S::value_type v;
+    ar.load(v);
+    s[i] = v;
+  }
+}
+
+template <class Source, class T>
+void load_adaptor(std::false_type, Source& src, const binary_info& info,
+                  storage_adaptor<T>& s) {
+  using V = typename T::value_type;
+  check_block(info, binary_storage::dense);
+  s.reset(info.cells);
+  if (std::is_trivially_copyable<V>::value &&
+      info.encoding == binary_encoding::raw) {
+    if (info.value_size != sizeof(V))
+      BOOST_THROW_EXCEPTION(std::runtime_error("cell type in binary data differs"));
+    if (info.cells) src.read_raw(&*s.begin(), info.cells * sizeof(V));
+  } else if (info.encoding == binary_encoding::elements) {
+    auto ar = src.elements();
+    for (auto&& x : s) ar.load(x);
+  } else {
+    BOOST_THROW_EXCEPTION(std::runtime_error("cell type in binary data differs"));
+  }
+}
+
+template <class Source, class T>
+void load_adaptor(std::true_type, Source& src, const binary_info& info,
+                  storage_adaptor<T>& s) {
+  check_block(info, binary_storage::map);
+  s.reset(info.cells);
+  auto& map = static_cast<T&>(unsafe_access::storage_adaptor_impl(s));
+  auto ar = src.elements();
+  std::uint64_t n = 0;
+  ar.load(n);
+  for (std::uint64_t i = 0; i < n; ++i) {
+    std::uint64_t k = 0;
+    typename T::mapped_type v;
+    ar.load(k);
+    ar.load(v);
+    if (k >= info.cells)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell index in binary data"));
+    map[static_cast<std::size_t>(k)] = std::move(v);
+  }
+}
+
+template <class Source, class T>
+void load_storage(Source& src, const binary_info& info, storage_adaptor<T>& s) {
+  load_adaptor(is_map_like<T>{}, src, info, s);
+}
+
+template <class Source, class A>
+void load_storage(Source& src, const binary_info& info, unlimited_storage<A>& s) {
+  using buffer_type = typename unlimited_storage<A>::buffer_type;
+  using large_int = typename unlimited_storage<A>::large_int;
+  check_block(info, binary_storage::unlimited);
+  using ntypes = mp11::mp_size<typename buffer_type::types>;
+  if (info.tier >= static_cast<std::uint32_t>(ntypes::value))
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell type in binary data"));
+  auto& buffer = unsafe_access::unlimited_storage_buffer(s);
+  buffer_type helper(buffer.alloc);
+  helper.type = info.tier;
+  helper.visit([&](const auto* tp) {
+    using T = remove_cvref_t<decltype(*tp)>;
+    buffer.template make<T>(info.cells);
+    auto p = static_cast<T*>(buffer.ptr);
+    if (std::is_same<T, large_int>::value) {
+      if (info.encoding != binary_encoding::elements)
+        BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell type in binary data"));
+      auto ar = src.elements();
+      for (std::size_t i = 0; i < info.cells; ++i) ar.load(p[i]);
+    } else if (info.encoding == binary_encoding::packed) {
+      if (!std::is_integral<T>::value)
+        BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell type in binary data"));
+      auto ar = src.elements();
+      unpack_cells(ar, p, info.cells);
+    } else {
+      if (info.encoding != binary_encoding::raw || info.value_size != sizeof(T))
+        BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell type in binary data"));
+      if (info.cells) src.read_raw(p, info.cells * sizeof(T));
+    }
+  });
+}
+
+inline void save_header(std::string& buf, const binary_info& info,
+                        std::size_t block_offset) {
+  binary_oarchive ar(buf);
+  ar.save_bytes(binary_magic, sizeof(binary_magic));
+  ar.save(binary_version);
+  ar.save(binary_byte_order_mark);
+  ar.save(info.rank);
+  ar.save(info.storage_type);
+  ar.save(info.encoding);
+  ar.save(info.value_size);
+  ar.save(info.tier);
+  ar.save(info.chunked ? binary_flag_chunked : std::uint32_t{0});
+  ar.save(info.cells);
+  ar.save(static_cast<std::uint64_t>(info.axes_size));
+  ar.save(static_cast<std::uint64_t>(block_offset));
+  ar.save(static_cast<std::uint64_t>(info.block_size));
+}
+
+// parses fixed-size header, returns offset of storage block
+inline std::size_t load_header(const char* data, binary_info& info) {
+  if (std::memcmp(data, binary_magic, sizeof(binary_magic)) != 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error("not a histogram in binary format"));
+  binary_iarchive ar(data + sizeof(binary_magic), data + binary_header_size);
+  std::uint32_t mark = 0, flags = 0;
+  std::uint64_t cells = 0, axes_size = 0, offset = 0, block_size = 0;
+  ar.load(info.version);
+  ar.load(mark);
+  if (mark != binary_byte_order_mark)
+    BOOST_THROW_EXCEPTION(std::runtime_error("byte order of binary data differs"));
+  if (info.version > binary_version)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unsupported version of binary format"));
+  ar.load(info.rank);
+  ar.load(info.storage_type);
+  ar.load(info.encoding);
+  ar.load(info.value_size);
+  ar.load(info.tier);
+  ar.load(flags);
+  info.chunked = (flags & binary_flag_chunked) != 0;
+  ar.load(cells);
+  ar.load(axes_size);
+  ar.load(offset);
+  ar.load(block_size);
+  info.cells = cells;
+  info.axes_size = static_cast<std::size_t>(axes_size);
+  info.block_size = static_cast<std::size_t>(block_size);
+  // written as binary_align(binary_header_size + axes_size), checked without overflow
+  if (offset < binary_header_size || axes_size > offset - binary_header_size ||
+      offset - binary_header_size - axes_size >= binary_alignment)
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid header of binary data"));
+  return static_cast<std::size_t>(offset);
+}
+
+template <class A>
+void load_axes(const binary_info& info, A& axes) {
+  auto begin = static_cast<const char*>(info.axes);
+  binary_iarchive ar(begin, begin + info.axes_size);
+  ar.load(axes);
+  if (get_size(axes) != info.rank)
+    BOOST_THROW_EXCEPTION(std::runtime_error("rank in binary data differs"));
+  if (bincount(axes) != info.cells)
+    BOOST_THROW_EXCEPTION(std::runtime_error("number of cells in binary data differs"));
+}
+
+// Returns number of threads for copying n bytes. A thread copies at least as many bytes
+// as it would sum cells of type double.
+template <class Policy>
+execution::parallel_policy binary_copy_policy(const Policy& policy, std::size_t n) {
+  return execution::parallel_policy(thread_count(policy, n / sizeof(double)));
+}
+
+// Reads block from memory, large blocks are copied in parallel if requested.
+template <class Policy>
+struct binary_memory_source {
+  void read_raw(void* p, std::size_t n) {
+    if (n > info.block_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    const auto out = static_cast<char*>(p);
+    const auto in = static_cast<const char*>(info.block);
+    const auto copy = binary_copy_policy(policy, n);
+    parallel_for(copy, copy.threads, [=](std::size_t begin, std::size_t end) {
+      const auto chunk = (n + copy.threads - 1) / copy.threads;
+      const auto a = (std::min)(n, begin * chunk);
+      const auto b = (std::min)(n, end * chunk);
+      std::memcpy(out + a, in + a, b - a);
+    });
+  }
+
+  binary_iarchive elements() const {
+    auto begin = static_cast<const char*>(info.block);
+    return {begin, begin + info.block_size};
+  }
+
+  const Policy& policy;
+  const binary_info& info;
+};
+
+struct binary_stream_source {
+  void read_raw(void* p, std::size_t n) {
+    if (n > info.block_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    if (!is.read(static_cast<char*>(p), static_cast<std::streamsize>(n)))
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  }
+
+  binary_iarchive elements() {
+    binary_read(is, buffer, info.block_size);
+    return {buffer.data(), buffer.data() + buffer.size()};
+  }
+
+  std::istream& is;
+  const binary_info& info;
+  std::string buffer;
+};
+
+// A chunk starts with the number of bytes in the chunk and the CRC-32 of these bytes.
+inline void save_chunk_header(std::ostream& os, std::uint32_t n, std::uint32_t crc) {
+  char buf[binary_chunk_header_size];
+  std::memcpy(buf, &n, 4);
+  std::memcpy(buf + 4, &crc, 4);
+  os.write(buf, sizeof(buf));
+}
+
+inline void check_chunk(const void* p, std::uint32_t n, std::uint32_t crc) {
+  if (crc32(p, n) != crc)
+    BOOST_THROW_EXCEPTION(std::runtime_error("checksum error in binary data"));
+}
+
+// Writes block in chunks. The checksum of the next chunk is computed while the previous
+// chunk is written by a background thread.
+inline void save_chunks(std::ostream& os, const char* data, std::size_t size,
+                        std::size_t chunk_size) {
+  struct slot_type {
+    const char* ptr;
+    std::uint32_t size, crc;
+  } slots[2];
+  std::size_t pos = 0;
+  pipeline(
+      [&](unsigned i) {
+        if (pos == size) return false;
+        const auto n = static_cast<std::uint32_t>((std::min)(chunk_size, size - pos));
+        slots[i] = {data + pos, n, crc32(data + pos, n)};
+        pos += n;
+        return true;
+      },
+      [&](unsigned i) {
+        save_chunk_header(os, slots[i].size, slots[i].crc);
+        os.write(slots[i].ptr, slots[i].size);
+      });
+}
+
+// Reads chunked block from memory, chunks are verified when they are copied. The chunk
+// headers are parsed first, then chunks are verified and copied in parallel if
+// requested.
+template <class Policy>
+struct binary_chunked_memory_source {
+  void read_raw(void* p, std::size_t n) {
+    if (n > info.block_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    struct chunk_type {
+      const char* ptr;
+      std::uint32_t size, crc;
+      std::size_t offset;
+    };
+    std::vector<chunk_type> chunks;
+    for (std::size_t offset = 0; offset < n;) {
+      std::uint32_t size = 0, crc = 0;
+      if (static_cast<std::size_t>(end - pos) < binary_chunk_header_size)
+        BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+      std::memcpy(&size, pos, 4);
+      std::memcpy(&crc, pos + 4, 4);
+      pos += binary_chunk_header_size;
+      if (size == 0 || size > n - offset || size > static_cast<std::size_t>(end - pos))
+        BOOST_THROW_EXCEPTION(std::runtime_error("invalid chunk in binary data"));
+      chunks.push_back({pos, size, crc, offset});
+      pos += size;
+      offset += size;
+    }
+    const auto out = static_cast<char*>(p);
+    parallel_for(binary_copy_policy(policy, n), chunks.size(),
+                 [&chunks, out](std::size_t begin, std::size_t end) {
+                   for (auto i = begin; i != end; ++i) {
+                     const auto& c = chunks[i];
+                     check_chunk(c.ptr, c.size, c.crc);
+                     std::memcpy(out + c.offset, c.ptr, c.size);
+                   }
+                 });
+  }
+
+  binary_iarchive elements() {
+    buffer.resize(info.block_size);
+    read_raw(&buffer[0], buffer.size());
+    return {buffer.data(), buffer.data() + buffer.size()};
+  }
+
+  const Policy& policy;
+  const binary_info& info;
+  const char* pos;
+  const char* end;
+  std::string buffer;
+};
+
+// Reads chunked block from a stream. Chunks are read directly into the destination,
+// the checksum of the previous chunk is verified by a background thread meanwhile.
+struct binary_chunked_stream_source {
+  void read_raw(void* p, std::size_t n) {
+    if (n > info.block_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    struct slot_type {
+      const char* ptr;
+      std::uint32_t size, crc;
+    } slots[2];
+    auto out = static_cast<char*>(p);
+    pipeline(
+        [&](unsigned i) {
+          if (n == 0) return false;
+          std::uint32_t size = 0, crc = 0;
+          read_chunk_header(n, size, crc);
+          if (!is.read(out, size))
+            BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+          slots[i] = {out, size, crc};
+          out += size;
+          n -= size;
+          return true;
+        },
+        [&](unsigned i) { check_chunk(slots[i].ptr, slots[i].size, slots[i].crc); });
+  }
+
+  // block size comes from the data, buffer grows only as far as chunks arrive
+  binary_iarchive elements() {
+    buffer.clear();
+    std::string chunk;
+    while (buffer.size() < info.block_size) {
+      std::uint32_t size = 0, crc = 0;
+      read_chunk_header(info.block_size - buffer.size(), size, crc);
+      binary_read(is, chunk, size);
+      check_chunk(chunk.data(), size, crc);
+      buffer += chunk;
+    }
+    return {buffer.data(), buffer.data() + buffer.size()};
+  }
+
+  // reads header of a chunk with at most n bytes
+  void read_chunk_header(std::size_t n, std::uint32_t& size, std::uint32_t& crc) {
+    char head[binary_chunk_header_size];
+    if (!is.read(head, sizeof(head)))
+      BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+    std::memcpy(&size, head, 4);
+    std::memcpy(&crc, head + 4, 4);
+    if (size == 0 || size > n)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid chunk in binary data"));
+  }
+
+  std::istream& is;
+  const binary_info& info;
+  std::string buffer;
+};
+
+// checks that block can be used in place as an array of T
+template <class T>
+void check_view(const binary_info& info) {
+  using types = typename unlimited_storage<>::buffer_type::types;
+  constexpr auto tier = mp11::mp_find<types, T>::value;
+  if (info.encoding != binary_encoding::raw || info.chunked ||
+      info.value_size != sizeof(T))
+    BOOST_THROW_EXCEPTION(std::runtime_error("storage block cannot be used in place"));
+  if (info.storage_type != binary_storage::dense &&
+      !(info.storage_type == binary_storage::unlimited && info.tier == tier))
+    BOOST_THROW_EXCEPTION(std::runtime_error("storage block cannot be used in place"));
+  if (reinterpret_cast<std::uintptr_t>(info.block) % alignof(T) != 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error("storage block is not aligned"));
+}
+
+template <class Source, class A, class S>
+void load_histogram(Source& src, const binary_info& info, histogram<A, S>& h) {
+  auto axes = unsafe_access::axes(h);
+  load_axes(info, axes);
+  auto storage = make_default(unsafe_access::storage(h));
+  load_storage(src, info, storage);
+  unsafe_access::axes(h) = std::move(axes);
+  unsafe_access::storage(h) = std::move(storage);
+}
+
+constexpr char binary_delta_magic[8] = {'B', 'H', 'I', 'S', 'T', 'D', 'L', 'T'};
+constexpr std::size_t binary_delta_header_size = 56;
+
+// kind of cell value in a delta, together with the size it identifies the cell type
+enum class binary_value_kind : std::uint32_t {
+  unsigned_integer = 0,
+  signed_integer = 1,
+  floating_point = 2,
+  other = 3
+};
+
+template <class T>
+constexpr binary_value_kind value_kind() noexcept {
+  return std::is_floating_point<T>::value
+             ? binary_value_kind::floating_point
+             : std::is_integral<T>::value
+                   ? (std::is_signed<T>::value ? binary_value_kind::signed_integer
+                                               : binary_value_kind::unsigned_integer)
+                   : binary_value_kind::other;
+}
+
+struct binary_delta_header {
+  binary_value_kind value_kind{};
+  std::uint32_t value_size = 0;
+  std::uint64_t cells = 0;
+  std::uint64_t block_size = 0;
+  std::uint64_t blocks = 0;
+  std::uint64_t payload_size = 0;
+};
+
+inline void save_delta_header(std::string& buf, const binary_delta_header& d) {
+  binary_oarchive ar(buf);
+  ar.save_bytes(binary_delta_magic, sizeof(binary_delta_magic));
+  ar.save(binary_version);
+  ar.save(binary_byte_order_mark);
+  ar.save(d.value_kind);
+  ar.save(d.value_size);
+  ar.save(d.cells);
+  ar.save(d.block_size);
+  ar.save(d.blocks);
+  ar.save(d.payload_size);
+}
+
+inline binary_delta_header load_delta_header(const char* data) {
+  if (std::memcmp(data, binary_delta_magic, sizeof(binary_delta_magic)) != 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error("not a histogram delta in binary format"));
+  binary_iarchive ar(data + sizeof(binary_delta_magic), data + binary_delta_header_size);
+  std::uint32_t version = 0, mark = 0;
+  ar.load(version);
+  ar.load(mark);
+  if (mark != binary_byte_order_mark)
+    BOOST_THROW_EXCEPTION(std::runtime_error("byte order of binary data differs"));
+  if (version > binary_version)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unsupported version of binary format"));
+  binary_delta_header d;
+  ar.load(d.value_kind);
+  ar.load(d.value_size);
+  ar.load(d.cells);
+  ar.load(d.block_size);
+  ar.load(d.blocks);
+  ar.load(d.payload_size);
+  if (d.block_size == 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid header of binary data"));
+  return d;
+}
+
+// Checks that delta matches the histogram, before the payload is read. For arithmetic
+// cells, the payload cannot be larger than all blocks with their indices.
+template <class A, class S>
+void check_delta(const binary_delta_header& d, const histogram<A, S>& h) {
+  using value_type = typename histogram<A, S>::value_type;
+  if (d.value_kind != value_kind<value_type>() || d.value_size != sizeof(value_type))
+    BOOST_THROW_EXCEPTION(std::runtime_error("cell type in binary data differs"));
+  if (d.cells != h.size())
+    BOOST_THROW_EXCEPTION(std::runtime_error("number of cells in binary data differs"));
+  const auto nblocks = (d.cells + d.block_size - 1) / d.block_size;
+  if (d.blocks > nblocks ||
+      (std::is_arithmetic<value_type>::value &&
+       d.payload_size > nblocks * sizeof(std::uint64_t) + d.cells * sizeof(value_type)))
+    BOOST_THROW_EXCEPTION(std::runtime_error("invalid header of binary data"));
+}
+
+// All cells are decoded before the first one is written, so that the histogram is
+// unchanged if the delta is invalid.
+template <class A, class S>
+void apply_delta_impl(const binary_delta_header& d, const char* payload,
+                      histogram<A, S>& h) {
+  using value_type = typename histogram<A, S>::value_type;
+  binary_iarchive ar(payload, payload + d.payload_size);
+  std::vector<std::pair<std::size_t, value_type>> cells;
+  for (std::uint64_t k = 0; k < d.blocks; ++k) {
+    std::uint64_t block = 0;
+    ar.load(block);
+    if (block >= (d.cells + d.block_size - 1) / d.block_size)
+      BOOST_THROW_EXCEPTION(std::runtime_error("invalid cell index in binary data"));
+    const auto begin = block * d.block_size;
+    const auto end = (std::min)(d.cells, begin + d.block_size);
+    for (auto i = begin; i < end; ++i) {
+      cells.emplace_back(static_cast<std::size_t>(i), value_type{});
+      ar.load(cells.back().second);
+    }
+  }
+  auto& s = unsafe_access::storage(h);
+  for (auto&& x : cells) s[x.first] = x.second;
+}
+
+} // namespace detail
+
+/** Decode header of histogram in binary format.
+
+  The returned info points into the data. For binary_encoding::raw, the storage block is
+  an array of info.cells values of info.value_size bytes each, which can be used in place.
+  The block is aligned to 64 bytes relative to the start of the data. This is not
+  possible if info.chunked is true, then the block is interleaved with chunk headers.
+
+  @param data pointer to the start of the binary data.
+  @param size size of the binary data in bytes.
+  @throws std::runtime_error if the data is not valid.
+*/
+inline binary_info read_binary_info(const void* data, std::size_t size) {
+  const auto p = static_cast<const char*>(data);
+  if (size < detail::binary_header_size)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  binary_info info;
+  const auto offset = detail::load_header(p, info);
+  // a chunked block is even larger than block_size, because of the chunk headers
+  if (offset > size || info.block_size > size - offset)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  info.axes = p + detail::binary_header_size;
+  info.block = p + offset;
+  return info;
+}
+
+/** Save histogram in binary format.
+
+  Storage blocks with raw encoding are written directly from the memory of the storage,
+  so the extra memory needed is independent of the number of cells.
+
+  With binary_encoding::packed, the cells of unlimited_storage are run-length and varint
+  encoded and restored at the narrowest cell type which holds the largest count. This
+  greatly reduces the size of sparse or low-count histograms, but the storage block can
+  no longer be used in place. Other storages and cells of type double ignore this option.
+
+  If chunk_size is not zero, the storage block is written in chunks of at most this many
+  bytes, each with a CRC-32 checksum which is verified when the histogram is loaded.
+  Checksums are computed and verified on a background thread, in parallel to writing
+  and reading of the stream. This is intended for very large histograms on unreliable
+  media or networks. Only raw blocks are streamed without an intermediate copy, other
+  encodings are assembled in memory first.
+
+  @param os output stream, should be opened in binary mode.
+  @param h histogram.
+  @param encoding preferred encoding of storage block, raw or packed (optional).
+  @param chunk_size size of chunks in bytes, or zero to write one block (optional).
+*/
+template <class A, class S>
+void save_binary(std::ostream& os, const histogram<A, S>& h,
+                 binary_encoding encoding = binary_encoding::raw,
+                 std::size_t chunk_size = 0) {
+  detail::binary_block b;
+  b.pack = encoding == binary_encoding::packed;
+  b.info.chunked = chunk_size > 0;
+  detail::save_storage(unsafe_access::storage(h), b);
+
+  std::string axes;
+  detail::binary_oarchive ar(axes);
+  ar.save(unsafe_access::axes(h));
+
+  b.info.rank = h.rank();
+  b.info.axes_size = axes.size();
+  b.info.block_size = b.raw ? b.info.cells * b.info.value_size : b.buffer.size();
+  const auto offset = detail::binary_align(detail::binary_header_size + axes.size());
+  std::string head;
+  detail::save_header(head, b.info, offset);
+  head += axes;
+  head.resize(offset, '\0');
+
+  os.write(head.data(), static_cast<std::streamsize>(head.size()));
+  const auto block = b.raw ? static_cast<const char*>(b.raw) : b.buffer.data();
+  if (b.info.chunked)
+    detail::save_chunks(os, block, b.info.block_size,
+                        (std::min)(chunk_size, detail::binary_max_chunk_size));
+  else
+    os.write(block, static_cast<std::streamsize>(b.info.block_size));
+}
+
+/** Load histogram from binary data in memory.
+
+  Storage blocks with raw encoding are copied with a single memcpy.
+
+  @param data pointer to the start of the binary data.
+  @param size size of the binary data in bytes.
+  @param h histogram, replaced on success and unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or does not match the histogram.
+*/
+template <class A, class S>
+void load_binary(const void* data, std::size_t size, histogram<A, S>& h) {
+  load_binary(execution::seq, data, size, h);
+}
+
+/** Load histogram from binary data in memory, copy and verify cells in parallel.
+
+  The header and the axes are decoded and checked first, and the storage is allocated
+  with the cell type given in the header. If the block has raw encoding, it is split into
+  pieces which are copied by several threads. This speeds up loading of large histograms
+  from memory-mapped files, when the pages are already in the page cache or the storage
+  device supports parallel reads. Chunked blocks are split at chunk boundaries, so that
+  the checksums are verified in parallel.
+
+  Only the copy and the checksums are parallel. Cells with elements, sparse, or packed
+  encoding are decoded in the calling thread, after the checksums of a chunked block
+  have been verified in parallel. Use raw encoding to load large histograms quickly.
+
+  @param policy execution policy, execution::seq or execution::par.
+  @param data pointer to the start of the binary data.
+  @param size size of the binary data in bytes.
+  @param h histogram, replaced on success and unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or does not match the histogram.
+*/
+template <class Policy, class A, class S>
+void load_binary(const Policy& policy, const void* data, std::size_t size,
+                 histogram<A, S>& h) {
+  const auto info = read_binary_info(data, size);
+  if (info.chunked) {
+    const auto end = static_cast<const char*>(data) + size;
+    detail::binary_chunked_memory_source<Policy> src{
+        policy, info, static_cast<const char*>(info.block), end, {}};
+    detail::load_histogram(src, info, h);
+  } else {
+    detail::binary_memory_source<Policy> src{policy, info};
+    detail::load_histogram(src, info, h);
+  }
+}
+
+/** Create read-only view of a histogram in binary format in memory.
+
+  The storage of the histogram refers to the cells in the data, which are not copied.
+  Only the axes are decoded, so the time needed does not depend on the number of cells.
+  If the data is a memory-mapped file, pages are loaded when cells are accessed. The data
+  must outlive the histogram.
+
+  The storage block must have raw encoding and cells of type T, which is the case for
+  histograms with dense_storage<T>, or unlimited_storage if the cells are currently of
+  type T. Blocks written in chunks cannot be used in place.
+
+  @param data pointer to the start of the binary data, aligned for T.
+  @param size size of the binary data in bytes.
+  @param h histogram view, replaced on success and unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or cannot be used in place.
+*/
+template <class A, class T>
+void load_binary(const void* data, std::size_t size,
+                 histogram<A, span_storage<const T>>& h) {
+  const auto info = read_binary_info(data, size);
+  auto axes = unsafe_access::axes(h);
+  detail::load_axes(info, axes);
+  detail::check_view<T>(info);
+  unsafe_access::axes(h) = std::move(axes);
+  unsafe_access::storage(h) = span_storage<const T>(
+      static_cast<const T*>(info.block), static_cast<std::size_t>(info.cells));
+}
+
+/** Load histogram in binary format from a stream.
+
+  Storage blocks with raw encoding are read directly into the memory of the storage, also
+  if the block is split into chunks. The extra memory needed is then independent of the
+  number of cells.
+
+  @param is input stream, should be opened in binary mode.
+  @param h histogram, replaced on success and unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or does not match the histogram.
+*/
+template <class A, class S>
+void load_binary(std::istream& is, histogram<A, S>& h) {
+  std::string head(detail::binary_header_size, '\0');
+  if (!is.read(&head[0], static_cast<std::streamsize>(head.size())))
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  binary_info info;
+  const auto offset = detail::load_header(head.data(), info);
+  std::string axes_buffer;
+  detail::binary_read(is, axes_buffer, offset - detail::binary_header_size);
+  info.axes = axes_buffer.data();
+
+  if (info.chunked) {
+    detail::binary_chunked_stream_source src{is, info, {}};
+    detail::load_histogram(src, info, h);
+  } else {
+    detail::binary_stream_source src{is, info, {}};
+    detail::load_histogram(src, info, h);
+  }
+}
+
+/** Save cells which were modified after a checkpoint in binary format.
+
+  Only blocks of cells which were modified after the checkpoint are written, see
+  tracking_storage. The cost is proportional to the number of modified blocks. The axes
+  are not written, the receiver must have a histogram with the same axes, for example,
+  one which was loaded from a full snapshot written with save_binary().
+
+  @param os output stream, should be opened in binary mode.
+  @param h histogram with tracking_storage.
+  @param since value returned by tracking_storage::checkpoint(), pass 0 to write all
+  blocks which were ever modified.
+*/
+template <class A, class S, std::size_t B>
+void save_delta(std::ostream& os, const histogram<A, tracking_storage<S, B>>& h,
+                std::uint64_t since) {
+  using value_type = typename tracking_storage<S, B>::value_type;
+  const auto& s = unsafe_access::storage(h);
+  detail::binary_delta_header d;
+  d.value_kind = detail::value_kind<value_type>();
+  d.value_size = sizeof(value_type);
+  d.cells = s.size();
+  d.block_size = B;
+  std::string payload;
+  detail::binary_oarchive ar(payload);
+  for (std::size_t block = 0; block < s.block_count(); ++block) {
+    if (!s.is_modified(block, since)) continue;
+    ++d.blocks;
+    ar.save(static_cast<std::uint64_t>(block));
+    const auto end = (std::min)(s.size(), (block + 1) * B);
+    for (auto i = block * B; i < end; ++i) {
+      const value_type v = s[i];
+      ar.save(v);
+    }
+  }
+  d.payload_size = payload.size();
+  std::string head;
+  detail::save_delta_header(head, d);
+  os.write(head.data(), static_cast<std::streamsize>(head.size()));
+  os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+}
+
+/** Apply delta written by save_delta() to a histogram.
+
+  The cells in the delta replace the cells of the histogram. The histogram may use any
+  storage with the same cell type as the one which wrote the delta. The delta records
+  whether the cell type is an unsigned or signed integer, floating point, or another
+  type, and its size; an exception is thrown if these differ.
+
+  @param data pointer to the start of the delta.
+  @param size size of the delta in bytes.
+  @param h histogram, unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or does not match the histogram.
+*/
+template <class A, class S>
+void apply_delta(const void* data, std::size_t size, histogram<A, S>& h) {
+  const auto p = static_cast<const char*>(data);
+  if (size < detail::binary_delta_header_size)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  const auto d = detail::load_delta_header(p);
+  detail::check_delta(d, h);
+  if (d.payload_size > size - detail::binary_delta_header_size)
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  detail::apply_delta_impl(d, p + detail::binary_delta_header_size, h);
+}
+
+/** Apply delta written by save_delta() to a histogram.
+
+  @param is input stream, should be opened in binary mode.
+  @param h histogram, unchanged if an exception is thrown.
+  @throws std::runtime_error if the data is not valid or does not match the histogram.
+*/
+template <class A, class S>
+void apply_delta(std::istream& is, histogram<A, S>& h) {
+  std::string buffer(detail::binary_delta_header_size, '\0');
+  if (!is.read(&buffer[0], static_cast<std::streamsize>(buffer.size())))
+    BOOST_THROW_EXCEPTION(std::runtime_error("unexpected end of binary data"));
+  const auto d = detail::load_delta_header(buffer.data());
+  detail::check_delta(d, h);
+  detail::binary_read(is, buffer, static_cast<std::size_t>(d.payload_size));
+  detail::apply_delta_impl(d, buffer.data(), h);
+}
+
+} // namespace histogram
+} // namespace boost
+
+#endif
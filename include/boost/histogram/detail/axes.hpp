@@ -18,6 +18,7 @@
 #include <boost/mp11/tuple.hpp>
 #include <boost/throw_exception.hpp>
 #include <functional>
+#include <initializer_list>
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
@@ -190,6 +191,27 @@ std::size_t bincount(const T& axes) {
   return n;
 }
 
+// for axis with static size() method
+template <class T>
+constexpr std::size_t static_extent() noexcept {
+  using O = axis::traits::static_options<T>;
+  return static_cast<std::size_t>(T::size()) +
+         decltype(O::test(axis::option::underflow))::value +
+         decltype(O::test(axis::option::overflow))::value;
+}
+
+template <class... Ts>
+constexpr std::size_t static_bincount_impl(mp11::mp_list<Ts...>) noexcept {
+  std::size_t n = 1;
+  for (auto s : {std::size_t{1}, static_extent<Ts>()...}) n *= s;
+  return n;
+}
+
+// number of cells for a tuple of axes with static size() method
+template <class T>
+using static_bincount = std::integral_constant<
+    std::size_t, static_bincount_impl(mp11::mp_rename<T, mp11::mp_list>{})>;
+
 } // namespace detail
 } // namespace histogram
 } // namespace boost
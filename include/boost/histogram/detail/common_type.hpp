@@ -39,7 +39,8 @@ static constexpr std::size_t type_rank() {
 }
 
 template <class T, class U>
-using common_storage = mp11::mp_if_c<(type_rank<T>() >= type_rank<U>()), T, U>;
+using common_storage =
+    owning_storage_t<mp11::mp_if_c<(type_rank<T>() >= type_rank<U>()), T, U>>;
 } // namespace detail
 } // namespace histogram
 } // namespace boost
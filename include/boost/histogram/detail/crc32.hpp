@@ -0,0 +1,63 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_CRC32_HPP
+#define BOOST_HISTOGRAM_DETAIL_CRC32_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// tables for slicing-by-8 computation of CRC-32 (ISO-HDLC, as used by zlib)
+inline const std::uint32_t* crc32_table() {
+  static const auto table = [] {
+    std::array<std::uint32_t, 8 * 256> t{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t c = i;
+      for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+      t[i] = c;
+    }
+    for (std::size_t s = 1; s < 8; ++s)
+      for (std::size_t i = 0; i < 256; ++i) {
+        const auto c = t[(s - 1) * 256 + i];
+        t[s * 256 + i] = (c >> 8) ^ t[c & 0xff];
+      }
+    return t;
+  }();
+  return table.data();
+}
+
+inline std::uint32_t load_le32(const unsigned char* p) noexcept {
+  return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 8 |
+         static_cast<std::uint32_t>(p[2]) << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+}
+
+// continues computation if the crc of the preceding data is passed
+inline std::uint32_t crc32(const void* data, std::size_t n, std::uint32_t crc = 0) {
+  const auto t = crc32_table();
+  auto p = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (; n >= 8; n -= 8, p += 8) {
+    const auto a = load_le32(p) ^ crc;
+    const auto b = load_le32(p + 4);
+    crc = t[7 * 256 + (a & 0xff)] ^ t[6 * 256 + ((a >> 8) & 0xff)] ^
+          t[5 * 256 + ((a >> 16) & 0xff)] ^ t[4 * 256 + (a >> 24)] ^
+          t[3 * 256 + (b & 0xff)] ^ t[2 * 256 + ((b >> 8) & 0xff)] ^
+          t[1 * 256 + ((b >> 16) & 0xff)] ^ t[b >> 24];
+  }
+  for (; n > 0; --n) crc = (crc >> 8) ^ t[(crc ^ *p++) & 0xff];
+  return ~crc;
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -14,6 +14,7 @@
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/detail/try_cast.hpp>
 #include <boost/histogram/fwd.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/function.hpp>
@@ -21,6 +22,7 @@
 #include <boost/mp11/list.hpp>
 #include <boost/mp11/tuple.hpp>
 #include <boost/throw_exception.hpp>
+#include <iterator>
 #include <mutex>
 #include <stdexcept>
 #include <tuple>
@@ -30,10 +32,6 @@ namespace boost {
 namespace histogram {
 namespace detail {
 
-template <class T>
-using has_underflow =
-    decltype(axis::traits::static_options<T>::test(axis::option::underflow));
-
 template <class T>
 struct is_growing
     : decltype(axis::traits::static_options<T>::test(axis::option::growth)) {};
@@ -48,6 +46,35 @@ template <class T>
 using has_growing_axis =
     mp11::mp_if<is_vector_like<T>, is_growing<mp11::mp_first<T>>, is_growing<T>>;
 
+template <class T>
+struct is_erased_axis : std::false_type {};
+
+template <class M>
+struct is_erased_axis<axis::any<M>> : std::true_type {};
+
+template <class... Ts>
+struct is_erased_axis<std::tuple<Ts...>> : mp11::mp_or<is_erased_axis<Ts>...> {};
+
+template <class T>
+using has_erased_axis =
+    mp11::mp_if<is_vector_like<T>, is_erased_axis<mp11::mp_first<T>>, is_erased_axis<T>>;
+
+// Options of axis::any are only known at run-time. Calls f with std::true_type if an axis
+// has the growth option and std::false_type otherwise, so that histograms of any axes
+// which do not grow use the faster code for non-growing axes.
+template <class A, class F>
+decltype(auto) growth_switch(const A& axes, F&& f) {
+  return static_if<has_erased_axis<A>>(
+      [](const auto& axes, auto& f) {
+        bool growing = false;
+        for_each_axis(axes, [&growing](const auto& a) {
+          growing |= (axis::traits::options(a) & axis::option::growth) != 0;
+        });
+        return growing ? f(std::true_type{}) : f(std::false_type{});
+      },
+      [](const auto&, auto& f) { return f(has_growing_axis<A>{}); }, axes, f);
+}
+
 /// Index with an invalid state
 struct optional_index {
   std::size_t idx = 0;
@@ -72,6 +99,14 @@ void linearize_value(optional_index& o, const Axis& a, const Value& v) {
   linearize(o, axis::traits::extent(a), j);
 }
 
+// for axis::any without growth option, needs only one call through the function table
+template <class M, class Value>
+void linearize_value(optional_index& o, const axis::any<M>& a, const Value& v) {
+  axis::index_type extent;
+  const auto j = a.linear_index(try_cast<double, std::invalid_argument>(v), extent);
+  linearize(o, extent, j);
+}
+
 // for variant that does not contain any growing axis
 template <class... Ts, class Value>
 void linearize_value(optional_index& o, const axis::variant<Ts...>& a, const Value& v) {
@@ -83,7 +118,8 @@ template <class Axis, class Value>
 bool linearize_value(optional_index& o, axis::index_type& s, Axis& a, const Value& v) {
   axis::index_type j;
   std::tie(j, s) = axis::traits::update(a, v);
-  j += has_underflow<Axis>::value;
+  // options are constexpr for most axes, but not for axis::any
+  j += axis::traits::options(a) & axis::option::underflow ? 1 : 0;
   linearize(o, axis::traits::extent(a), j);
   return s != 0;
 }
@@ -127,8 +163,8 @@ void grow_storage(const A& axes, S& storage, const axis::index_type* shifts) {
     sit = shifts;
     dit = data;
     for_each_axis(axes, [&](const auto& a) {
-      using opt = axis::traits::static_options<decltype(a)>;
-      if (opt::test(axis::option::underflow)) {
+      const auto opt = axis::traits::options(a);
+      if (opt & axis::option::underflow) {
         if (dit->idx == 0) {
           // axis has underflow and we are in the underflow bin:
           // keep storage pointer unchanged
@@ -137,7 +173,7 @@ void grow_storage(const A& axes, S& storage, const axis::index_type* shifts) {
           return;
         }
       }
-      if (opt::test(axis::option::overflow)) {
+      if (opt & axis::option::overflow) {
         if (dit->idx == dit->old_extent - 1) {
           // axis has overflow and we are in the overflow bin:
           // move storage pointer to corresponding overflow bin position
@@ -299,7 +335,9 @@ typename SM::first_type::iterator fill(A& axes, SM& sm, const std::tuple<Us...>&
                              : 0;
   std::lock_guard<typename SM::second_type> lk{sm.second()};
   auto& storage = sm.first();
-  optional_index idx = to_index<i, n>(has_growing_axis<A>(), axes, storage, tus);
+  optional_index idx = growth_switch(axes, [&](auto growing) {
+    return to_index<i, n>(growing, axes, storage, tus);
+  });
   if (idx) {
     using mp11::mp_int;
     fill_impl1(mp_int<iws.first>{}, mp_int<iws.second>{}, storage[*idx], tus);
@@ -308,6 +346,71 @@ typename SM::first_type::iterator fill(A& axes, SM& sm, const std::tuple<Us...>&
   return storage.end();
 }
 
+template <class F, class... Ts>
+void for_each_mutable_axis(std::tuple<Ts...>& axes, F&& f) {
+  mp11::tuple_for_each(axes, std::forward<F>(f));
+}
+
+template <class F, class T>
+void for_each_mutable_axis(T& axes, F&& f) {
+  for (auto& a : axes) f(a);
+}
+
+// histogram has only non-growing axes: type of each axis is resolved once per chunk of
+// values, then indices are computed in a loop over the concrete axis type
+template <class A, class S, class Iterable>
+void fill_n(std::false_type, A& axes, S& storage, const Iterable& args, std::size_t n) {
+  constexpr std::size_t chunk = 512;
+  optional_index idx[chunk];
+  for (std::size_t start = 0; start < n; start += chunk) {
+    const auto m = (std::min)(chunk, n - start);
+    std::fill(idx, idx + m, optional_index{});
+    auto column = std::begin(args);
+    for_each_axis(axes, [&](const auto& a) {
+      const auto x = std::begin(*column++) + start;
+      for (std::size_t k = 0; k < m; ++k) linearize_value(idx[k], a, x[k]);
+    });
+    for (std::size_t k = 0; k < m; ++k)
+      if (idx[k])
+        fill_impl2(has_operator_preincrement<remove_cvref_t<decltype(storage[0])>>{},
+                   storage[*idx[k]]);
+  }
+}
+
+// histogram has growing axes: each value may change the axes, so process one at a time
+template <class A, class S, class Iterable>
+void fill_n(std::true_type, A& axes, S& storage, const Iterable& args, std::size_t n) {
+  for (std::size_t k = 0; k < n; ++k) {
+    optional_index idx;
+    axis::index_type shifts[buffer_size<A>::value];
+    auto s = shifts;
+    auto column = std::begin(args);
+    bool update_needed = false;
+    for_each_mutable_axis(axes, [&](auto& a) {
+      update_needed |= linearize_value(idx, *s++, a, std::begin(*column++)[k]);
+    });
+    if (update_needed) grow_storage(axes, storage, shifts);
+    if (idx)
+      fill_impl2(has_operator_preincrement<remove_cvref_t<decltype(storage[0])>>{},
+                 storage[*idx]);
+  }
+}
+
+template <class A, class SM, class Iterable>
+void fill_n(A& axes, SM& sm, const Iterable& args) {
+  using std::begin;
+  using std::end;
+  if (get_size(args) != get_size(axes))
+    BOOST_THROW_EXCEPTION(std::invalid_argument("number of arguments != histogram rank"));
+  const auto n = static_cast<std::size_t>(std::distance(begin(*begin(args)),
+                                                         end(*begin(args))));
+  for (const auto& column : args)
+    if (static_cast<std::size_t>(std::distance(begin(column), end(column))) != n)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("columns must have equal length"));
+  std::lock_guard<typename SM::second_type> lk{sm.second()};
+  growth_switch(axes, [&](auto growing) { fill_n(growing, axes, sm.first(), args, n); });
+}
+
 template <typename A, typename... Us>
 optional_index at(const A& axes, const std::tuple<Us...>& args) {
   if (get_size(axes) != sizeof...(Us))
@@ -174,10 +174,14 @@ BOOST_HISTOGRAM_DETECT(has_method_options, (&T::options));
 
 BOOST_HISTOGRAM_DETECT(has_allocator, &T::get_allocator);
 
+BOOST_HISTOGRAM_DETECT(has_growth_handler, &T::get_growth_handler);
+
 BOOST_HISTOGRAM_DETECT(is_indexable, (std::declval<T&>()[0]));
 
 BOOST_HISTOGRAM_DETECT(is_transform, (&T::forward, &T::inverse));
 
+BOOST_HISTOGRAM_DETECT(has_fast_forward, (std::declval<const T&>().fast_forward(0.0)));
+
 BOOST_HISTOGRAM_DETECT(is_indexable_container,
                        (std::declval<T>()[0], &T::size, std::begin(std::declval<T>()),
                         std::end(std::declval<T>())));
@@ -198,6 +202,8 @@ BOOST_HISTOGRAM_DETECT(is_map_like,
 // ok: is_axis is false for axis::variant, operator() is templated
 BOOST_HISTOGRAM_DETECT(is_axis, (&T::size, &T::index));
 
+BOOST_HISTOGRAM_DETECT(has_static_size, (std::integral_constant<int, T::size()>{}));
+
 BOOST_HISTOGRAM_DETECT(is_iterable,
                        (std::begin(std::declval<T&>()), std::end(std::declval<T&>())));
 
@@ -321,8 +327,31 @@ struct requires_convertible {};
 
 template <class T>
 auto make_default(const T& t) {
-  return static_if<has_allocator<T>>([](const auto& t) { return T(t.get_allocator()); },
-                                     [](const auto&) { return T{}; }, t);
+  return static_if<has_allocator<T>>(
+      [](const auto& t) { return T(t.get_allocator()); },
+      [](const auto& t) {
+        return static_if<has_growth_handler<T>>(
+            [](const auto& t) { return T(t.get_growth_handler()); },
+            [](const auto&) { return T{}; }, t);
+      },
+      t);
+}
+
+// Storage of histograms which algorithms create from a histogram with storage S.
+// Storages which do not own their memory specialize this to an owning storage.
+template <class S>
+struct owning_storage {
+  using type = S;
+};
+
+template <class S>
+using owning_storage_t = typename owning_storage<S>::type;
+
+template <class S>
+owning_storage_t<S> make_owning_default(const S& s) {
+  return static_if<std::is_same<owning_storage_t<S>, S>>(
+      [](const auto& s) { return make_default(s); },
+      [](const auto&) { return owning_storage_t<S>{}; }, s);
 }
 
 template <class T>
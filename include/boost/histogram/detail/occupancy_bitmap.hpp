@@ -0,0 +1,88 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_OCCUPANCY_BITMAP_HPP
+#define BOOST_HISTOGRAM_DETAIL_OCCUPANCY_BITMAP_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/meta.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// x must not be zero
+inline unsigned countr_zero(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long n;
+  _BitScanForward64(&n, x);
+  return static_cast<unsigned>(n);
+#else
+  unsigned n = 0;
+  for (; !(x & 1); x >>= 1) ++n;
+  return n;
+#endif
+}
+
+template <class T, class U>
+bool is_occupied(const T& x, const U& zero, std::true_type) {
+  return !(x == zero);
+}
+
+// cells which cannot be compared are never considered empty
+template <class T, class U>
+bool is_occupied(const T&, const U&, std::false_type) {
+  return true;
+}
+
+// Bit k is set if cell k differs from the default-constructed value. The inner loop
+// over a block of 64 cells has no branches, compilers vectorize it for simple storages.
+template <class Value, class Iterator>
+std::vector<std::uint64_t> make_occupancy_bitmap(Iterator it, std::size_t n) {
+  std::vector<std::uint64_t> bitmap((n + 63) / 64);
+  const Value zero{};
+  using comparable = has_operator_equal<Value>;
+  for (auto&& word : bitmap) {
+    const auto m = std::min(n, std::size_t{64});
+    std::uint64_t w = 0;
+    for (std::size_t k = 0; k < m; ++k)
+      w |= static_cast<std::uint64_t>(is_occupied(it[k], zero, comparable{})) << k;
+    word = w;
+    it += m;
+    n -= m;
+  }
+  return bitmap;
+}
+
+// returns position of first set bit at or after pos, or n if there is none
+inline std::size_t next_occupied(const std::uint64_t* bitmap, std::size_t pos,
+                                 std::size_t n) noexcept {
+  if (pos >= n) return n;
+  auto i = pos / 64;
+  const auto nwords = (n + 63) / 64;
+  auto w = bitmap[i] & (~std::uint64_t{0} << (pos % 64));
+  while (!w) {
+    if (++i == nwords) return n;
+    w = bitmap[i];
+  }
+  return i * 64 + countr_zero(w);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PARALLEL_FOR_HPP
+#define BOOST_HISTOGRAM_DETAIL_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/execution.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/mp11/function.hpp>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// If the number of threads is chosen automatically, each thread gets at least this many
+// work items. Starting a thread costs about as much as summing this many cells.
+constexpr std::size_t parallel_grain_size = 1 << 14;
+
+inline unsigned thread_count(execution::sequenced_policy, std::size_t) noexcept {
+  return 1;
+}
+
+inline unsigned thread_count(const execution::parallel_policy& p,
+                             std::size_t n) noexcept {
+  std::size_t t = p.threads;
+  if (t == 0) {
+    t = std::max(std::thread::hardware_concurrency(), 1u);
+    t = std::min(t, n / parallel_grain_size);
+  }
+  t = std::min(t, n);
+  return static_cast<unsigned>(std::max(t, std::size_t{1}));
+}
+
+// joins all threads on scope exit, also if thread creation throws
+struct thread_group : std::vector<std::thread> {
+  ~thread_group() {
+    for (auto& t : *this)
+      if (t.joinable()) t.join();
+  }
+};
+
+// Calls f(begin, end) on contiguous, non-overlapping chunks which cover [0, n). Chunks
+// are processed in parallel if requested by the policy, the calling thread processes
+// the first chunk. The first exception thrown by any f is rethrown after all threads
+// are joined.
+template <class Policy, class F>
+void parallel_for(const Policy& policy, std::size_t n, F&& f) {
+  const unsigned nthreads = thread_count(policy, n);
+  if (nthreads == 1) {
+    f(std::size_t{0}, n);
+    return;
+  }
+  const std::size_t chunk = (n + nthreads - 1) / nthreads;
+  std::vector<std::exception_ptr> errors(nthreads);
+  auto run = [&f, &errors, chunk, n](unsigned k) {
+    const auto begin = std::min(n, k * chunk);
+    const auto end = std::min(n, begin + chunk);
+    try {
+      f(begin, end);
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  };
+  {
+    thread_group threads;
+    threads.reserve(nthreads - 1);
+    for (unsigned k = 1; k < nthreads; ++k) threads.emplace_back(run, k);
+    run(0);
+  }
+  for (auto&& e : errors)
+    if (e) std::rethrow_exception(e);
+}
+
+// Storages in which distinct cells may be written concurrently. Writes into
+// unlimited_storage may reallocate the buffer, writes into map-based storages may insert.
+template <class S>
+struct has_independent_writes : std::false_type {};
+
+template <class T>
+struct has_independent_writes<storage_adaptor<T>>
+    : mp11::mp_or<is_vector_like<T>, is_array_like<T>> {};
+
+template <class T>
+struct has_independent_writes<span_storage<T>> : std::true_type {};
+
+// Calls parallel_for if the first argument is std::true_type, otherwise calls f(0, n)
+// in the calling thread.
+template <class Policy, class F>
+void parallel_for_if(std::false_type, const Policy&, std::size_t n, F&& f) {
+  f(std::size_t{0}, n);
+}
+
+template <class Policy, class F>
+void parallel_for_if(std::true_type, const Policy& policy, std::size_t n, F&& f) {
+  parallel_for(policy, n, std::forward<F>(f));
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
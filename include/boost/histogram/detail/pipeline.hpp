@@ -0,0 +1,90 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_DETAIL_PIPELINE_HPP
+#define BOOST_HISTOGRAM_DETAIL_PIPELINE_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// Two-stage pipeline with two slots. The calling thread runs first(slot) until it returns
+// false, a background thread runs second(slot) on each slot filled by first. While the
+// background thread works on one slot, the calling thread fills the other. The first
+// exception thrown by either stage stops the pipeline and is rethrown after the
+// background thread is joined. No thread is started if there is only one item.
+template <class First, class Second>
+void pipeline(First&& first, Second&& second) {
+  if (!first(0u)) return;
+  if (!first(1u)) {
+    second(0u);
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool full[2] = {true, true};
+  bool done = false;
+  std::exception_ptr error;
+
+  std::thread worker([&] {
+    for (unsigned slot = 0;; slot ^= 1) {
+      {
+        std::unique_lock<std::mutex> lk(mutex);
+        cv.wait(lk, [&] { return full[slot] || done || error; });
+        if (error || !full[slot]) return;
+      }
+      try {
+        second(slot);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mutex);
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lk(mutex);
+        full[slot] = false;
+      }
+      cv.notify_all();
+    }
+  });
+
+  try {
+    for (unsigned slot = 0;; slot ^= 1) {
+      {
+        std::unique_lock<std::mutex> lk(mutex);
+        cv.wait(lk, [&] { return !full[slot] || error; });
+        if (error) break;
+      }
+      if (!first(slot)) break;
+      {
+        std::lock_guard<std::mutex> lk(mutex);
+        full[slot] = true;
+      }
+      cv.notify_all();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lk(mutex);
+    if (!error) error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    done = true;
+  }
+  cv.notify_all();
+  worker.join();
+  if (error) std::rethrow_exception(error);
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_EXECUTION_HPP
+#define BOOST_HISTOGRAM_EXECUTION_HPP
+
+/**
+  \file boost/histogram/execution.hpp
+  Execution policies accepted by algorithms which can distribute work over threads.
+
+  The policies are modelled after the C++17 execution policies, but work with C++14.
+*/
+
+namespace boost {
+namespace histogram {
+namespace execution {
+
+/// Run algorithm in the calling thread.
+struct sequenced_policy {};
+
+/** Distribute algorithm over several threads.
+
+  The threads are started and joined by the algorithm. Small workloads are always
+  processed in the calling thread, since starting a thread is not free.
+*/
+struct parallel_policy {
+  /// Number of threads to use, zero means std::thread::hardware_concurrency().
+  unsigned threads = 0;
+
+  constexpr parallel_policy() = default;
+  constexpr explicit parallel_policy(unsigned n) noexcept : threads(n) {}
+};
+
+/// Instance of sequenced_policy.
+constexpr sequenced_policy seq{};
+
+/// Instance of parallel_policy which uses all hardware threads.
+constexpr parallel_policy par{};
+
+} // namespace execution
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -14,6 +14,8 @@
 
 #include <boost/core/use_default.hpp>
 #include <boost/histogram/detail/attribute.hpp> // BOOST_HISTOGRAM_NODISCARD
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -34,6 +36,8 @@ using real_index_type = double;
 /// Empty metadata type
 struct null_type {};
 
+class interned_string;
+
 #ifndef BOOST_HISTOGRAM_DOXYGEN_INVOKED
 
 namespace transform {
@@ -54,13 +58,30 @@ template <class Value = double, class MetaData = use_default, class Options = us
           class Allocator = std::allocator<Value>>
 class variable;
 
+template <class Value = double, class MetaData = use_default, class Options = use_default>
+class log_linear;
+
+template <unsigned Bins, std::intmax_t Start, std::intmax_t Stop,
+          class Unit = use_default, class MetaData = use_default,
+          class Options = use_default>
+class static_regular;
+
+template <int Start, int Stop, class MetaData = use_default, class Options = use_default>
+class static_integer;
+
 template <class Value = int, class MetaData = use_default, class Options = use_default,
           class Allocator = std::allocator<Value>>
 class category;
 
+template <class Value = int, class MetaData = use_default>
+class top_k_category;
+
 template <class... Ts>
 class variant;
 
+template <class MetaData = use_default>
+class any;
+
 #endif // BOOST_HISTOGRAM_DOXYGEN_INVOKED
 
 } // namespace axis
@@ -100,6 +121,9 @@ class unlimited_storage;
 template <class T>
 class storage_adaptor;
 
+template <class T>
+class span_storage;
+
 #endif // BOOST_HISTOGRAM_DOXYGEN_INVOKED
 
 /// Vector-like storage for fast zero-overhead access to cells.
@@ -120,6 +144,9 @@ using weighted_profile_storage = dense_storage<accumulators::weighted_mean<>>;
 
 #ifndef BOOST_HISTOGRAM_DOXYGEN_INVOKED
 
+template <class Storage = dense_storage<double>, std::size_t BlockSize = 256>
+class tracking_storage;
+
 template <class Axes, class Storage = default_storage>
 class BOOST_HISTOGRAM_NODISCARD histogram;
 
@@ -188,6 +188,24 @@ public:
     return detail::fill(axes_, storage_and_mutex_, t);
   }
 
+  /** Fill histogram with many values at once.
+
+    The argument is an iterable of columns, one for each axis, and each column is an
+    iterable of values. All columns must have the same length, which is the number of
+    fills. This gives the same result as calling operator() with each row, but the type
+    of each axis is resolved only once per batch of values instead of once per value,
+    which is faster for histograms with axis::variant. The mutex is locked only once.
+
+    Passing the wrong number of columns or columns of different length causes a throw of
+    std::invalid_argument.
+
+    @param args iterable of columns of values.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  void fill(const Iterable& args) {
+    detail::fill_n(axes_, storage_and_mutex_, args);
+  }
+
   /** Access cell value at integral indices.
 
     You can pass indices as individual arguments, as a std::tuple of integers, or as an
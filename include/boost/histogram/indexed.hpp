@@ -7,14 +7,19 @@
 #ifndef BOOST_HISTOGRAM_INDEXED_HPP
 #define BOOST_HISTOGRAM_INDEXED_HPP
 
+#include <algorithm>
 #include <boost/histogram/axis/traits.hpp>
 #include <boost/histogram/detail/attribute.hpp>
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/iterator_adaptor.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/occupancy_bitmap.hpp>
 #include <boost/histogram/fwd.hpp>
+#include <cstdint>
+#include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace boost {
 namespace histogram {
@@ -26,6 +31,9 @@ namespace histogram {
 enum class coverage {
   inner, /*!< iterate over inner bins, exclude underflow and overflow */
   all,   /*!< iterate over all bins, including underflow and overflow */
+  nonzero, /*!< iterate over all bins which are not empty, including underflow and
+              overflow; a bin is empty if it compares equal to a default-constructed
+              value */
 };
 
 /** Input iterator range over histogram bins with multi-dimensional index.
@@ -33,6 +41,10 @@ enum class coverage {
   The iterator returned by begin() can only be incremented. begin() may only be called
   once, calling it a second time returns the end() iterator. If several copies of the
   input iterators exist, the other copies become invalid if one of them is incremented.
+
+  The range can be partitioned into independent sub-ranges with subrange(), for example
+  to process them in parallel. A sub-range covers a contiguous interval of positions in
+  the iteration order. Creating it costs O(rank), independent of its position.
 */
 template <class Histogram>
 class BOOST_HISTOGRAM_NODISCARD indexed_range {
@@ -43,19 +55,37 @@ private:
 
 public:
   using value_iterator = decltype(std::declval<Histogram>().begin());
-  using value_reference = typename value_iterator::reference;
+  using value_reference = typename std::iterator_traits<value_iterator>::reference;
   class range_iterator;
 
 private:
   struct state_type {
     struct index_data {
-      axis::index_type idx, begin, end, extent;
+      axis::index_type idx, begin, end, extent, under;
     };
 
     state_type(histogram_type& h) : hist_(h) {}
 
+    // Sets indices to position p in iteration order and returns the linear index of the
+    // cell in the storage. The position one past the last cell maps to the end.
+    std::size_t seek(std::size_t p) noexcept {
+      std::size_t offset = 0, stride = 1;
+      const auto clast = indices_ + hist_.rank() - 1;
+      for (auto c = indices_; c <= clast; ++c) {
+        const auto n = static_cast<std::size_t>(c->end - c->begin);
+        c->idx = c->begin + static_cast<axis::index_type>(c < clast ? p % n : p);
+        p /= n;
+        offset += static_cast<std::size_t>(c->idx + c->under) * stride;
+        stride *= static_cast<std::size_t>(c->extent);
+      }
+      return offset;
+    }
+
     histogram_type& hist_;
     index_data indices_[buffer_size];
+    // only used for coverage::nonzero, positions in iteration order
+    const std::uint64_t* bitmap_ = nullptr;
+    std::size_t first_ = 0, pos_ = 0, last_ = 0;
   };
 
 public:
@@ -195,6 +225,17 @@ public:
     pointer operator->() noexcept { return &value_; }
 
     range_iterator& operator++() {
+      auto& s = value_.state_;
+      if (s.bitmap_) {
+        // jump to next non-empty cell
+        const auto pos =
+            s.first_ +
+            detail::next_occupied(s.bitmap_, s.pos_ - s.first_ + 1, s.last_ - s.first_);
+        value_.iter_ += static_cast<std::ptrdiff_t>(pos - s.pos_);
+        s.pos_ = pos;
+        if (pos < s.last_) s.seek(pos);
+        return *this;
+      }
       std::size_t stride = 1;
       auto c = value_.state_.indices_;
       ++c->idx;
@@ -230,34 +271,72 @@ public:
   };
 
   indexed_range(Histogram& hist, coverage cov)
-      : state_(hist), begin_(hist.begin()), end_(begin_) {
-    std::size_t stride = 1;
+      : indexed_range(hist, cov, 0, static_cast<std::size_t>(-1)) {}
+
+  /** Range over cells at positions [first, last) in iteration order.
+
+    The positions are counted like in a range which covers the whole histogram. Positions
+    past the end are clamped. For coverage::nonzero, empty cells count as positions, too.
+  */
+  indexed_range(Histogram& hist, coverage cov, std::size_t first, std::size_t last)
+      : state_(hist), begin_(hist.begin()), end_(begin_), cov_(cov) {
     auto ca = state_.indices_;
-    const auto clast = ca + state_.hist_.rank() - 1;
-    state_.hist_.for_each_axis([ca, clast, cov, &stride, this](const auto& a) mutable {
-      using opt = axis::traits::static_options<decltype(a)>;
-      constexpr int under = opt::test(axis::option::underflow);
-      constexpr int over = opt::test(axis::option::overflow);
-      const auto size = a.size();
-
-      ca->extent = size + under + over;
+    const bool all = cov != coverage::inner;
+    std::size_t size = 1;
+    state_.hist_.for_each_axis([ca, all, &size](const auto& a) mutable {
+      const auto opt = axis::traits::options(a);
+      const int under = opt & axis::option::underflow ? 1 : 0;
+      const int over = opt & axis::option::overflow ? 1 : 0;
+      const auto n = a.size();
+
+      ca->extent = n + under + over;
+      ca->under = under;
       // -1 if underflow and cover all, else 0
-      ca->begin = cov == coverage::all ? -under : 0;
+      ca->begin = all ? -under : 0;
       // size + 1 if overflow and cover all, else size
-      ca->end = cov == coverage::all ? size + over : size;
+      ca->end = all ? n + over : n;
       ca->idx = ca->begin;
 
-      begin_ += (ca->begin + under) * stride;
-      end_ += ((ca < clast ? ca->begin : ca->end) + under) * stride;
-
-      stride *= ca->extent;
+      size *= static_cast<std::size_t>(ca->end - ca->begin);
       ++ca;
     });
+
+    last_ = std::min(last, size);
+    first_ = std::min(first, last_);
+    if (size > 0) {
+      end_ += static_cast<std::ptrdiff_t>(state_.seek(last_));
+      begin_ += static_cast<std::ptrdiff_t>(state_.seek(first_));
+    }
   }
 
-  range_iterator begin() noexcept {
+  /// Number of positions covered by the range, including empty cells for
+  /// coverage::nonzero.
+  std::size_t size() const noexcept { return last_ - first_; }
+
+  /** Sub-range over positions [first, last) of this range.
+
+    The sub-ranges of one range are independent and may be iterated concurrently, for
+    example, by different threads. Positions past the end are clamped.
+  */
+  indexed_range subrange(std::size_t first, std::size_t last) const {
+    last = std::min(last, size());
+    return {state_.hist_, cov_, first_ + std::min(first, last), first_ + last};
+  }
+
+  range_iterator begin() {
     auto begin = begin_;
     begin_ = end_;
+    if (cov_ == coverage::nonzero && begin != end_) {
+      // the bitmap is computed here, so that sub-ranges compute their part in parallel
+      using cell_type = typename detail::remove_cvref_t<histogram_type>::value_type;
+      bitmap_ = detail::make_occupancy_bitmap<cell_type>(begin, size());
+      state_.bitmap_ = bitmap_.data();
+      state_.first_ = first_;
+      state_.last_ = last_;
+      state_.pos_ = first_ + detail::next_occupied(state_.bitmap_, 0, size());
+      begin += static_cast<std::ptrdiff_t>(state_.pos_ - first_);
+      if (state_.pos_ < last_) state_.seek(state_.pos_);
+    }
     return {state_, begin};
   }
   range_iterator end() noexcept { return {state_, end_}; }
@@ -265,6 +344,9 @@ public:
 private:
   state_type state_;
   value_iterator begin_, end_;
+  coverage cov_;
+  std::size_t first_, last_;
+  std::vector<std::uint64_t> bitmap_;
 };
 
 /** Generates an indexed iterator range over the histogram cells.
@@ -284,10 +366,17 @@ private:
   A indexed_range::detached_accessor can be stored for later use, but manually copying the
   data of interest from the accessor is usually more efficient.
 
+  With coverage::nonzero, the storage is scanned once when begin() is called and the
+  positions of non-empty cells are recorded in a bitmap. The iteration then jumps directly
+  from one non-empty cell to the next, which is much faster for sparse histograms. Cells
+  which are modified during the iteration are visited or skipped according to their
+  state at the time begin() was called.
+
   @returns indexed_range
 
   @param hist Reference to the histogram.
-  @param cov  Iterate over all or only inner bins (optional, default: inner).
+  @param cov  Iterate over all, only inner, or only non-empty bins (optional, default:
+              inner).
  */
 template <typename Histogram>
 auto indexed(Histogram&& hist, coverage cov = coverage::inner) {
@@ -0,0 +1,364 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_INTEGRAL_HISTOGRAM_HPP
+#define BOOST_HISTOGRAM_INTEGRAL_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/linearize.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/parallel_for.hpp>
+#include <boost/histogram/execution.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/mp11/utility.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/** Summed-area table of a histogram for O(1) box queries.
+
+  The table holds the N-dimensional prefix sums over all cells of a histogram, including
+  underflow and overflow bins. The sum over any axis-aligned box of cells is then
+  computed from 2^N table entries, independent of the size of the box.
+
+  The table can be updated with new values. Updates are collected in a small buffer, which
+  is consulted by each query and folded into the table once it holds about sqrt(number of
+  cells) entries. An update changes all table entries at or above its cell on every axis.
+  These entries are changed in place, unless the buffered updates together touch more
+  entries than a full pass over the table, then the updates are folded in with one pass.
+
+  The source histogram must have arithmetic cell values, like int or double. Storages
+  with accumulators, like weight_storage, are not supported.
+
+  Prefix sums of floating point values suffer from cancellation, the result of a box query
+  may differ from the directly computed sum by a few ulp of the total sum. Integral counts
+  are exact up to 2^53 for the default value type.
+
+  @tparam Axes axes type of the source histogram, must not contain growing axes.
+  @tparam Value arithmetic type to hold the sums.
+*/
+template <class Axes, class Value = double>
+class integral_histogram {
+  static_assert(std::is_arithmetic<Value>::value, "Value must be arithmetic");
+  static_assert(!detail::has_growing_axis<Axes>::value,
+                "integral_histogram does not support growing axes");
+
+public:
+  using axes_type = Axes;
+  using value_type = Value;
+
+  /** Build table from histogram.
+
+    The prefix sums along each axis are independent and are computed in parallel if
+    requested by the policy.
+
+    @param h source histogram.
+    @param policy execution policy (optional, default: execution::seq).
+  */
+  template <class S, class Policy = execution::sequenced_policy>
+  explicit integral_histogram(const histogram<Axes, S>& h, const Policy& policy = {})
+      : axes_(unsafe_access::axes(h))
+      , extents_(detail::make_stack_buffer<axis::index_type>(axes_))
+      , shifts_(detail::make_stack_buffer<axis::index_type>(axes_)) {
+    static_assert(std::is_arithmetic<typename histogram<Axes, S>::value_type>::value,
+                  "integral_histogram requires arithmetic cell values");
+    auto e = extents_.begin();
+    auto s = shifts_.begin();
+    std::size_t n = 1;
+    detail::for_each_axis(axes_, [&](const auto& a) {
+      *e = axis::traits::extent(a);
+      *s++ = axis::traits::options(a) & axis::option::underflow ? 1 : 0;
+      n *= static_cast<std::size_t>(*e++ + 1);
+    });
+    table_.resize(n, value_type{});
+
+    const auto& storage = unsafe_access::storage(h);
+    detail::parallel_for(policy, storage.size(),
+                         [this, &storage](std::size_t begin, std::size_t end) {
+                           for (auto i = begin; i < end; ++i)
+                             table_[padded_index(i)] =
+                                 static_cast<value_type>(storage[i]);
+                         });
+    accumulate(table_, policy);
+    flush_limit_ = std::max(std::size_t{16},
+                            static_cast<std::size_t>(std::sqrt(static_cast<double>(n))));
+  }
+
+  /// Number of axes (dimensions).
+  unsigned rank() const noexcept { return static_cast<unsigned>(extents_.size()); }
+
+  /// Add one count at the cell which corresponds to the values.
+  template <class... Ts>
+  void operator()(const Ts&... ts) {
+    operator()(std::make_tuple(ts...));
+  }
+
+  /// Add weight at the cell which corresponds to the values.
+  template <class T, class... Ts>
+  void operator()(const weight_type<T>& w, const Ts&... ts) {
+    add(detail::to_index<0, sizeof...(Ts)>(std::false_type{}, axes_, dummy_,
+                                           std::tie(ts...)),
+        static_cast<value_type>(w.value));
+  }
+
+  /// Add one count at the cell which corresponds to the values in the tuple.
+  template <class... Ts>
+  void operator()(const std::tuple<Ts...>& t) {
+    add(detail::to_index<0, sizeof...(Ts)>(std::false_type{}, axes_, dummy_, t),
+        value_type{1});
+  }
+
+  /** Add value at cell with integral indices.
+
+    @param indices iterable of axis indices, -1 addresses the underflow bin.
+    @param x value to add.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  void add_at(const Iterable& indices, value_type x) {
+    add(detail::at(axes_, indices), x);
+  }
+
+  /// @copydoc add_at()
+  void add_at(std::initializer_list<axis::index_type> indices, value_type x) {
+    add_at<std::initializer_list<axis::index_type>>(indices, x);
+  }
+
+  /// Fold buffered updates into the table.
+  void flush() {
+    if (pending_.empty()) return;
+    // an update changes all table entries at or above its cell on every axis; these are
+    // updated in place, unless that costs more than accumulating a table of deltas
+    const auto limit = rank() * table_.size();
+    std::size_t cost = 0;
+    for (const auto& p : pending_)
+      if ((cost += orthant_size(p.first)) > limit) break;
+    if (cost <= limit) {
+      for (const auto& p : pending_) add_to_orthant(p.first, p.second);
+    } else {
+      delta_.assign(table_.size(), value_type{}); // keeps capacity of previous flush
+      for (const auto& p : pending_) delta_[padded_index(p.first)] += p.second;
+      accumulate(delta_, execution::seq);
+      auto it = delta_.begin();
+      for (auto&& x : table_) x += *it++;
+    }
+    pending_.clear();
+  }
+
+  /** Sum over cells in half-open box [begin, end).
+
+    Indices refer to the axis indices, -1 is the underflow bin and axis.size() the
+    overflow bin. Indices outside of the valid range are clamped, so that a box with
+    begin = -1 and end = axis.size() + 1 covers the whole axis including flow bins.
+
+    @param begin iterable with the first index on each axis.
+    @param end iterable with one past the last index on each axis.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  value_type sum(const Iterable& begin, const Iterable& end) const {
+    return sum_impl(begin, end, 0);
+  }
+
+  /// @copydoc sum()
+  value_type sum(std::initializer_list<axis::index_type> begin,
+                 std::initializer_list<axis::index_type> end) const {
+    return sum_impl(begin, end, 0);
+  }
+
+  /** Sum over cells in closed box [first, last].
+
+    Like sum(), but the upper indices are included in the box.
+
+    @param first iterable with the first index on each axis.
+    @param last iterable with the last index on each axis.
+  */
+  template <class Iterable, class = detail::requires_iterable<Iterable>>
+  value_type sum_closed(const Iterable& first, const Iterable& last) const {
+    return sum_impl(first, last, 1);
+  }
+
+  /// @copydoc sum_closed()
+  value_type sum_closed(std::initializer_list<axis::index_type> first,
+                        std::initializer_list<axis::index_type> last) const {
+    return sum_impl(first, last, 1);
+  }
+
+  /// Sum over all cells, including underflow and overflow bins.
+  value_type sum() const {
+    value_type r = table_.back();
+    for (const auto& p : pending_) r += p.second;
+    return r;
+  }
+
+private:
+  template <class Iterable>
+  value_type sum_impl(const Iterable& first, const Iterable& last,
+                      axis::index_type closed) const {
+    if (detail::get_size(first) != rank() || detail::get_size(last) != rank())
+      BOOST_THROW_EXCEPTION(
+          std::invalid_argument("number of indices != histogram rank"));
+    // internal index range [lo, hi) on each axis, shifted to start at zero
+    auto lo = detail::make_stack_buffer<axis::index_type>(axes_);
+    auto hi = detail::make_stack_buffer<axis::index_type>(axes_);
+    using std::begin;
+    auto fit = begin(first);
+    auto lit = begin(last);
+    for (unsigned d = 0; d < rank(); ++d) {
+      const auto f = static_cast<axis::index_type>(*fit++) + shifts_[d];
+      const auto l = static_cast<axis::index_type>(*lit++) + shifts_[d] + closed;
+      lo[d] = std::min(std::max(f, 0), extents_[d]);
+      hi[d] = std::min(std::max(l, 0), extents_[d]);
+      if (!(lo[d] < hi[d])) return value_type{};
+    }
+
+    // inclusion-exclusion over the 2^N corners of the box
+    value_type r{};
+    const std::size_t corners = std::size_t{1} << rank();
+    for (std::size_t mask = 0; mask < corners; ++mask) {
+      std::size_t j = 0, stride = 1;
+      bool negative = false;
+      for (unsigned d = 0; d < rank(); ++d) {
+        const bool low = mask & (std::size_t{1} << d);
+        negative ^= low;
+        j += static_cast<std::size_t>(low ? lo[d] : hi[d]) * stride;
+        stride *= static_cast<std::size_t>(extents_[d] + 1);
+      }
+      if (negative)
+        r -= table_[j];
+      else
+        r += table_[j];
+    }
+
+    for (const auto& p : pending_) {
+      auto i = p.first;
+      bool inside = true;
+      for (unsigned d = 0; d < rank(); ++d) {
+        const auto e = static_cast<std::size_t>(extents_[d]);
+        const auto k = static_cast<axis::index_type>(i % e);
+        i /= e;
+        inside &= lo[d] <= k && k < hi[d];
+      }
+      if (inside) r += p.second;
+    }
+    return r;
+  }
+
+  void add(const detail::optional_index& idx, value_type x) {
+    if (!idx) return;
+    pending_.emplace_back(*idx, x);
+    if (pending_.size() >= flush_limit_) flush();
+  }
+
+  // maps linear index of histogram storage to linear index of table with padding
+  std::size_t padded_index(std::size_t i) const noexcept {
+    std::size_t j = 0, stride = 1;
+    for (auto e : extents_) {
+      const auto ue = static_cast<std::size_t>(e);
+      j += (i % ue + 1) * stride;
+      i /= ue;
+      stride *= ue + 1;
+    }
+    return j;
+  }
+
+  // number of table entries which are changed by an update of storage cell i
+  std::size_t orthant_size(std::size_t i) const noexcept {
+    std::size_t n = 1;
+    for (auto e : extents_) {
+      const auto ue = static_cast<std::size_t>(e);
+      n *= ue - i % ue;
+      i /= ue;
+    }
+    return n;
+  }
+
+  // adds x to all table entries at or above storage cell i on every axis
+  void add_to_orthant(std::size_t i, value_type x) {
+    auto lo = detail::make_stack_buffer<std::size_t>(axes_);
+    auto k = detail::make_stack_buffer<std::size_t>(axes_);
+    auto stride = detail::make_stack_buffer<std::size_t>(axes_);
+    std::size_t base = 0, s = 1;
+    for (unsigned d = 0; d < rank(); ++d) {
+      const auto ue = static_cast<std::size_t>(extents_[d]);
+      lo[d] = k[d] = i % ue + 1;
+      i /= ue;
+      stride[d] = s;
+      if (d > 0) base += lo[d] * s;
+      s *= ue + 1;
+    }
+    const auto n0 = static_cast<std::size_t>(extents_[0] + 1);
+    for (;;) {
+      auto p = table_.data() + base;
+      for (auto q = lo[0]; q < n0; ++q) p[q] += x;
+      unsigned d = 1;
+      for (; d < rank(); ++d) {
+        if (++k[d] < static_cast<std::size_t>(extents_[d] + 1)) {
+          base += stride[d];
+          break;
+        }
+        base -= (k[d] - 1 - lo[d]) * stride[d];
+        k[d] = lo[d];
+      }
+      if (d == rank()) break;
+    }
+  }
+
+  // computes prefix sums along each axis, the lines along an axis are independent
+  template <class Policy>
+  void accumulate(std::vector<value_type>& t, const Policy& policy) const {
+    std::size_t stride = 1;
+    for (auto e : extents_) {
+      const auto n = static_cast<std::size_t>(e + 1);
+      const auto lines = t.size() / n;
+      detail::parallel_for(policy, lines,
+                           [&t, stride, n](std::size_t begin, std::size_t end) {
+                             for (auto line = begin; line < end; ++line) {
+                               const auto inner = line % stride;
+                               const auto outer = line / stride;
+                               auto p = t.data() + outer * stride * n + inner;
+                               for (std::size_t k = 1; k < n; ++k)
+                                 p[k * stride] += p[(k - 1) * stride];
+                             }
+                           });
+      stride *= n;
+    }
+  }
+
+  axes_type axes_;
+  detail::stack_buffer<axis::index_type, axes_type> extents_, shifts_;
+  std::vector<value_type> table_, delta_;
+  std::vector<std::pair<std::size_t, value_type>> pending_;
+  std::size_t flush_limit_ = 16;
+  int dummy_ = 0; // dummy storage argument for detail::to_index
+};
+
+/** Make integral_histogram from histogram.
+
+  The value type of the table is double.
+
+  @param h source histogram.
+  @param policy execution policy (optional, default: execution::seq).
+*/
+template <class A, class S, class Policy = execution::sequenced_policy>
+auto make_integral_histogram(const histogram<A, S>& h, const Policy& policy = {}) {
+  return integral_histogram<A>(h, policy);
+}
+
+} // namespace histogram
+} // namespace boost
+
+#endif
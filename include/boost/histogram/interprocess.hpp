@@ -0,0 +1,107 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_INTERPROCESS_HPP
+#define BOOST_HISTOGRAM_INTERPROCESS_HPP
+
+#include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+  \file boost/histogram/interprocess.hpp
+
+  Histograms in shared memory, using
+  [Boost.Interprocess](https://www.boost.org/doc/libs/develop/doc/html/interprocess.html).
+ */
+
+namespace boost {
+namespace histogram {
+
+/**
+  Storage with cells in a managed memory segment.
+
+  The cells are allocated from the segment manager and referred to with offset pointers,
+  so the storage is valid in all processes which map the segment, even if it is mapped
+  to different addresses.
+
+  @tparam T type of cells.
+  @tparam SegmentManager segment manager of a managed memory segment.
+*/
+template <class T, class SegmentManager =
+                       interprocess::managed_shared_memory::segment_manager>
+using interprocess_storage = storage_adaptor<
+    interprocess::vector<T, interprocess::allocator<T, SegmentManager>>>;
+
+/**
+  Histogram for concurrent filling from several processes.
+
+  The default cells are thread-safe counters, which are lock-free on common platforms
+  and can then be incremented concurrently from different processes.
+
+  @tparam Axes std::tuple of axis types.
+  @tparam T type of cells.
+  @tparam SegmentManager segment manager of a managed memory segment.
+*/
+template <class Axes, class T = accumulators::thread_safe<std::uint64_t>,
+          class SegmentManager = interprocess::managed_shared_memory::segment_manager>
+using interprocess_histogram = histogram<Axes, interprocess_storage<T, SegmentManager>>;
+
+/**
+  Find histogram with the given name in a managed memory segment or construct it.
+
+  Every process which maps the segment can call this with the same arguments and gets a
+  reference to the same histogram, which is constructed by the first call. The axes are
+  ignored if the histogram already exists. Other processes may also access an existing
+  histogram with `segment.find<H>(name)`, where H is the returned type.
+
+  The histogram object including its axes is placed in the segment, so the axes must not
+  refer to memory outside of it. Use axis::null_type as metadata instead of std::string
+  and the segment allocator for axis::variable and axis::category. Growing axes are not
+  supported, because the mutex of the histogram cannot be shared between processes.
+
+  @tparam T type of cells (optional, default: thread-safe 64 bit counter).
+  @param segment managed memory segment, like interprocess::managed_shared_memory.
+  @param name name of the histogram object in the segment.
+  @param axis First axis instance.
+  @param axes Other axis instances.
+*/
+template <class T = accumulators::thread_safe<std::uint64_t>, class Segment, class Axis,
+          class... Axes, class = detail::requires_axis<Axis>>
+auto& make_interprocess_histogram(Segment& segment, const char* name, Axis&& axis,
+                                  Axes&&... axes) {
+  using A = std::tuple<detail::remove_cvref_t<Axis>, detail::remove_cvref_t<Axes>...>;
+  using SM = typename Segment::segment_manager;
+  using S = interprocess_storage<T, SM>;
+  using H = histogram<A, S>;
+  static_assert(!detail::has_growing_axis<A>::value,
+                "growing axes are not supported in shared memory");
+  return *segment.template find_or_construct<H>(name)(
+      A(std::forward<Axis>(axis), std::forward<Axes>(axes)...),
+      S(typename S::allocator_type(segment.get_segment_manager())));
+}
+
+namespace detail {
+// histograms created by algorithms from a shared histogram are local to the process
+template <class T, class SegmentManager>
+struct owning_storage<interprocess_storage<T, SegmentManager>> {
+  using type = dense_storage<T>;
+};
+} // namespace detail
+
+} // namespace histogram
+} // namespace boost
+
+#endif
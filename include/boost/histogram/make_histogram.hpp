@@ -13,11 +13,14 @@
 */
 
 #include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/meta.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
 #include <boost/histogram/unlimited_storage.hpp> // = default_storage
+#include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/utility.hpp>
+#include <array>
 #include <tuple>
 #include <vector>
 
@@ -62,6 +65,27 @@ auto make_weighted_histogram(Axis&& axis, Axes&&... axes) {
                              std::forward<Axes>(axes)...);
 }
 
+/**
+  Make histogram with compile-time number of cells which does not allocate memory.
+
+  All axes must have a static size() method, like axis::static_regular and
+  axis::static_integer. The number of cells is then computed at compile-time and the
+  cells are stored in a std::array inside the histogram. Extents and strides of the axes
+  are compile-time constants, which the compiler folds into the index computation.
+  @tparam T cell type (optional, default: double).
+  @param axis First axis instance.
+  @param axes Other axis instances.
+*/
+template <class T = double, class Axis, class... Axes,
+          class = detail::requires_axis<Axis>>
+auto make_static_histogram(Axis&& axis, Axes&&... axes) {
+  using A = std::tuple<detail::remove_cvref_t<Axis>, detail::remove_cvref_t<Axes>...>;
+  static_assert(mp11::mp_all_of<A, detail::has_static_size>::value,
+                "all axes must have a static size() method");
+  return make_histogram_with(std::array<T, detail::static_bincount<A>::value>(),
+                             std::forward<Axis>(axis), std::forward<Axes>(axes)...);
+}
+
 /**
   Make histogram from iterable range and custom storage.
   @param storage Storage or container with standard interface (any vector, array, or map).
@@ -15,7 +15,12 @@
 #include <boost/histogram/accumulators/weighted_sum.hpp>
 #include <boost/histogram/axis/category.hpp>
 #include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/interned_string.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
 #include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_integer.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/axis/top_k_category.hpp>
 #include <boost/histogram/axis/variable.hpp>
 #include <boost/histogram/axis/variant.hpp>
 #include <boost/histogram/histogram.hpp>
@@ -117,6 +122,13 @@ void serialize(Archive& ar, pow& t, unsigned /* version */) {
 template <class Archive>
 void serialize(Archive&, null_type&, unsigned /* version */) {}
 
+template <class Archive>
+void interned_string::serialize(Archive& ar, unsigned /* version */) {
+  auto s = str();
+  ar& serialization::make_nvp("value", s);
+  if (Archive::is_loading::value) *this = interned_string(std::move(s));
+}
+
 template <class T, class Tr, class M, class O>
 template <class Archive>
 void regular<T, Tr, M, O>::serialize(Archive& ar, unsigned /* version */) {
@@ -125,6 +137,7 @@ void regular<T, Tr, M, O>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("meta", size_meta_.second());
   ar& serialization::make_nvp("min", min_);
   ar& serialization::make_nvp("delta", delta_);
+  if (Archive::is_loading::value) update_scale();
 }
 
 template <class T, class M, class O>
@@ -135,6 +148,27 @@ void integer<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("min", min_);
 }
 
+template <class T, class M, class O>
+template <class Archive>
+void log_linear<T, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("size", size_meta_.first());
+  ar& serialization::make_nvp("meta", size_meta_.second());
+  ar& serialization::make_nvp("bits", bits_);
+  ar& serialization::make_nvp("min", min_);
+}
+
+template <unsigned B, std::intmax_t S, std::intmax_t E, class U, class M, class O>
+template <class Archive>
+void static_regular<B, S, E, U, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("meta", meta_);
+}
+
+template <int S, int E, class M, class O>
+template <class Archive>
+void static_integer<S, E, M, O>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("meta", meta_);
+}
+
 template <class T, class M, class O, class A>
 template <class Archive>
 void variable<T, M, O, A>::serialize(Archive& ar, unsigned /* version */) {
@@ -149,6 +183,33 @@ void category<T, M, O, A>::serialize(Archive& ar, unsigned /* version */) {
   ar& serialization::make_nvp("meta", vec_meta_.second());
 }
 
+template <class T, class M>
+template <class Archive>
+void top_k_category<T, M>::serialize(Archive& ar, unsigned /* version */) {
+  ar& serialization::make_nvp("seq", seq_);
+  ar& serialization::make_nvp("meta", meta_);
+  ar& serialization::make_nvp("k", k_);
+  ar& serialization::make_nvp("counters", counters_);
+  ar& serialization::make_nvp("min_count", min_count_);
+  std::vector<T> keys;
+  std::vector<unsigned> counts;
+  if (Archive::is_saving::value) {
+    for (auto&& kv : table_) {
+      keys.push_back(kv.first);
+      counts.push_back(kv.second);
+    }
+  }
+  ar& serialization::make_nvp("keys", keys);
+  ar& serialization::make_nvp("counts", counts);
+  if (Archive::is_loading::value) {
+    lookup_.clear();
+    for (index_type i = 0; i < size(); ++i) lookup_.emplace(seq_[i], i);
+    table_.clear();
+    for (std::size_t i = 0; i < keys.size() && i < counts.size(); ++i)
+      table_.emplace(keys[i], counts[i]);
+  }
+}
+
 // variant_proxy is a workaround to remain backward compatible in the serialization
 // format. It uses only the public interface of axis::variant for serialization and
 // therefore works independently of the underlying variant implementation.
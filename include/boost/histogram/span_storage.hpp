@@ -0,0 +1,159 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_SPAN_STORAGE_HPP
+#define BOOST_HISTOGRAM_SPAN_STORAGE_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/axes.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace histogram {
+
+/**
+  Storage which refers to cells in memory owned by someone else.
+
+  The storage does not allocate, copying it creates another reference to the same memory.
+  The memory must outlive the storage and all its copies. This allows one to fill directly
+  into buffers which are managed elsewhere, like shared memory, pinned I/O buffers or
+  slabs of an arena. Calling reset() with the current number of cells only clears them.
+  Algorithms which create new histograms, like algorithm::project or the arithmetic
+  operators, return histograms with an owning dense_storage.
+
+  A different number of cells is requested by growing axes or when a histogram is
+  constructed with a storage of a different size. The storage then obtains a new buffer
+  from the growth handler, if one was passed to the constructor. The handler is called
+  with the new number of cells and must return a pointer to a buffer of at least this
+  size. The storage does not release buffers. The previous buffer is still read after
+  the handler returns, since the cells are copied when an axis grows.
+
+  With a const value type, the storage is a read-only view, for example, of a histogram
+  saved with save_binary() and then memory-mapped, see load_binary(). Cells are only read
+  when they are accessed, so pages of a memory-mapped file are loaded lazily.
+
+  @tparam T type of cells, may be const.
+*/
+template <class T>
+class span_storage {
+public:
+  static constexpr bool has_threading_support =
+      accumulators::is_thread_safe<std::remove_const_t<T>>::value;
+
+  using value_type = std::remove_const_t<T>;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using growth_handler = std::function<T*(std::size_t)>;
+
+  span_storage() = default;
+
+  /// Refer to n cells starting at data.
+  span_storage(T* data, std::size_t n, growth_handler g = {})
+      : data_(data), size_(n), grow_(std::move(g)) {}
+
+  /// Refer to no cells, buffers are requested from the growth handler.
+  explicit span_storage(growth_handler g) : grow_(std::move(g)) {}
+
+  /**
+    Set all cells to zero, the buffer is replaced only if n differs from its size.
+
+    @throws std::length_error if n differs from the number of cells and there is no
+            growth handler or the handler returned a null pointer.
+    @throws std::logic_error if the storage is read-only and not empty.
+  */
+  void reset(std::size_t n) {
+    if (n != size_) {
+      T* p = grow_ ? grow_(n) : nullptr;
+      if (p == nullptr && n > 0)
+        BOOST_THROW_EXCEPTION(std::length_error("span_storage cannot change its size"));
+      data_ = p;
+      size_ = n;
+    }
+    clear(std::is_const<T>{});
+  }
+
+  std::size_t size() const noexcept { return size_; }
+
+  reference operator[](std::size_t i) noexcept { return data_[i]; }
+  const_reference operator[](std::size_t i) const noexcept { return data_[i]; }
+
+  iterator begin() noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator begin() const noexcept { return data_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  /// Return pointer to first cell.
+  T* data() const noexcept { return data_; }
+
+  /// Return growth handler, which may be empty.
+  const growth_handler& get_growth_handler() const noexcept { return grow_; }
+
+  template <class U, class = detail::requires_iterable<U>>
+  bool operator==(const U& u) const {
+    using std::begin;
+    using std::end;
+    return std::equal(this->begin(), this->end(), begin(u), end(u), detail::equal{});
+  }
+
+private:
+  void clear(std::true_type) {
+    if (size_ > 0)
+      BOOST_THROW_EXCEPTION(std::logic_error("span_storage is read-only"));
+  }
+
+  void clear(std::false_type) { std::fill_n(data_, size_, value_type{}); }
+
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+  growth_handler grow_;
+};
+
+/// Read-only histogram over cells in external memory, see load_binary().
+template <class Axes, class T = double>
+using histogram_view = histogram<Axes, span_storage<const T>>;
+
+/**
+  Make read-only histogram over existing cells.
+
+  @param data pointer to the first cell, the cells must outlive the histogram.
+  @param n number of cells, must match the number of bins including flow bins.
+  @param axes std::tuple or std::vector of axes.
+  @throws std::invalid_argument if the number of cells does not match.
+*/
+template <class T, class Axes, class = detail::requires_axes<Axes>>
+auto make_histogram_view(const T* data, std::size_t n, Axes&& axes) {
+  using A = detail::remove_cvref_t<Axes>;
+  if (detail::bincount(axes) != n)
+    BOOST_THROW_EXCEPTION(std::invalid_argument("number of cells does not match axes"));
+  histogram_view<A, T> h;
+  unsafe_access::axes(h) = std::forward<Axes>(axes);
+  unsafe_access::storage(h) = span_storage<const T>(data, n);
+  return h;
+}
+
+namespace detail {
+template <class T>
+struct owning_storage<span_storage<T>> {
+  using type = dense_storage<std::remove_const_t<T>>;
+};
+} // namespace detail
+
+} // namespace histogram
+} // namespace boost
+
+#endif
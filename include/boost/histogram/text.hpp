@@ -0,0 +1,450 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_TEXT_HPP
+#define BOOST_HISTOGRAM_TEXT_HPP
+
+#include <algorithm>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/static_if.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+/**
+  \file boost/histogram/text.hpp
+
+  Export of histograms to JSON and CSV.
+
+  The formats are intended for plotting and other tools, the histogram cannot be restored
+  from them; use boost/histogram/binary.hpp or boost/histogram/serialization.hpp for that.
+  Bin edges are computed once per axis with one call to the value method per bin, numbers
+  are formatted with std::to_chars if the standard library provides it, and the output is
+  assembled in a buffer which is written to the stream in chunks.
+ */
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// longest output of format_number
+constexpr std::size_t text_number_size = 32;
+
+#ifdef __cpp_lib_to_chars
+template <class T>
+char* format_number(char* p, T x) {
+  return std::to_chars(p, p + text_number_size, x).ptr;
+}
+#else
+// shortest representation which restores x, std::to_chars does this directly
+inline char* format_number(char* p, double x) {
+  auto n = std::snprintf(p, text_number_size, "%.15g", x);
+  if (std::strtod(p, nullptr) != x) n = std::snprintf(p, text_number_size, "%.17g", x);
+  return p + n;
+}
+
+template <class T>
+char* format_number_impl(std::true_type, char* p, T x) {
+  return p + std::snprintf(p, text_number_size, "%lld", static_cast<long long>(x));
+}
+
+template <class T>
+char* format_number_impl(std::false_type, char* p, T x) {
+  return p + std::snprintf(p, text_number_size, "%llu",
+                           static_cast<unsigned long long>(x));
+}
+
+template <class T>
+char* format_number(char* p, T x) {
+  return static_if<std::is_floating_point<T>>(
+      [p](auto x) { return format_number(p, static_cast<double>(x)); },
+      [p](auto x) { return format_number_impl(std::is_signed<T>{}, p, x); }, x);
+}
+#endif
+
+// collects output in a buffer which is written to the stream when it is full
+class text_writer {
+public:
+  text_writer(std::ostream& os, std::size_t chunk_size)
+      : os_(os), buffer_((std::max)(chunk_size, 4 * text_number_size)) {}
+
+  void put(char c) {
+    reserve(1);
+    *pos_++ = c;
+  }
+
+  void write(const char* s, std::size_t n) {
+    if (n > free()) {
+      flush();
+      if (n > buffer_.size()) {
+        os_.write(s, static_cast<std::streamsize>(n));
+        flushed_ += n;
+        return;
+      }
+    }
+    std::memcpy(pos_, s, n);
+    pos_ += n;
+  }
+
+  void write(const char* s) { write(s, std::strlen(s)); }
+
+  void write(const std::string& s) { write(s.data(), s.size()); }
+
+  // JSON has no representation for infinity and NaN
+  template <class T>
+  void number(T x, bool json) {
+    reserve(text_number_size);
+    if (json && !is_finite(x))
+      pos_ = std::copy_n("null", 4, pos_);
+    else
+      pos_ = format_number(pos_, x);
+  }
+
+  // strings are quoted and escaped for JSON, or quoted for CSV
+  void string(const std::string& s, bool json) {
+    put('"');
+    for (auto c : s) {
+      if (c == '"') {
+        if (json)
+          write("\\\"", 2);
+        else
+          write("\"\"", 2);
+      } else if (json && c == '\\') {
+        write("\\\\", 2);
+      } else if (json && static_cast<unsigned char>(c) < 0x20) {
+        char tmp[8];
+        std::snprintf(tmp, sizeof(tmp), "\\u%04x", static_cast<unsigned>(c));
+        write(tmp, 6);
+      } else {
+        put(c);
+      }
+    }
+    put('"');
+  }
+
+  void flush() {
+    const auto n = static_cast<std::size_t>(pos_ - buffer_.data());
+    os_.write(buffer_.data(), static_cast<std::streamsize>(n));
+    flushed_ += n;
+    pos_ = buffer_.data();
+  }
+
+  // number of bytes written so far
+  std::size_t tellp() const noexcept {
+    return flushed_ + static_cast<std::size_t>(pos_ - buffer_.data());
+  }
+
+private:
+  template <class T>
+  static bool is_finite(T x) {
+    return !std::is_floating_point<T>::value || std::isfinite(static_cast<double>(x));
+  }
+
+  std::size_t free() const noexcept {
+    return static_cast<std::size_t>(buffer_.data() + buffer_.size() - pos_);
+  }
+
+  void reserve(std::size_t n) {
+    if (n > free()) flush();
+  }
+
+  std::ostream& os_;
+  std::vector<char> buffer_;
+  char* pos_ = buffer_.data();
+  std::size_t flushed_ = 0;
+};
+
+BOOST_HISTOGRAM_DETECT(has_method_value_and_variance,
+                       (std::declval<const T&>().value(),
+                        std::declval<const T&>().variance()));
+
+template <class T>
+void write_text_value(text_writer& w, const T& x, bool json) {
+  static_if<std::is_arithmetic<T>>(
+      [&w, json](const auto& x) { w.number(x, json); },
+      [&w, json](const auto& x) {
+        static_if<std::is_convertible<const T&, std::string>>(
+            [&w, json](const auto& x) { w.string(x, json); },
+            [&w, json](const auto& x) {
+              std::ostringstream os;
+              os << x;
+              w.string(os.str(), json);
+            },
+            x);
+      },
+      x);
+}
+
+// cells are written as numbers, or as value and variance for accumulators
+template <class T>
+void write_text_cell(text_writer& w, const T& x, bool json) {
+  static_if<has_method_value_and_variance<T>>(
+      [&w, json](const auto& x) {
+        w.put(json ? '[' : '"');
+        w.number(x.value(), json);
+        w.put(',');
+        w.number(x.variance(), json);
+        w.put(json ? ']' : '"');
+      },
+      [&w, json](const auto& x) {
+        static_if_c<(!std::is_arithmetic<T>::value &&
+                     std::is_convertible<const T&, double>::value)>(
+            [&w, json](const auto& x) { w.number(static_cast<double>(x), json); },
+            [&w, json](const auto& x) { write_text_value(w, x, json); }, x);
+      },
+      x);
+}
+
+template <class Axis>
+bool is_continuous(const Axis& a) {
+  return static_if<has_method_value<Axis>>(
+      [](const auto& a) {
+        return value_method_switch([](const auto&) { return false; },
+                                   [](const auto&) { return true; }, a);
+      },
+      [](const auto&) { return false; }, a);
+}
+
+// Calls f with each bin edge, index 0 to size, if the axis is continuous, or with each
+// bin value, index 0 to size - 1, if it is discrete. Axes without values are skipped.
+template <class Axis, class F>
+void for_each_axis_value(const Axis& a, F&& f) {
+  static_if<has_method_value<Axis>>(
+      [&f](const auto& a) {
+        const auto n = a.size() + (is_continuous(a) ? 1 : 0);
+        for (axis::index_type i = 0; i < n; ++i) f(axis::traits::value(a, i));
+      },
+      [](const auto&) {}, a);
+}
+
+template <class Axis>
+void write_text_label(text_writer& w, const Axis& a) {
+  const auto& m = axis::traits::metadata(a);
+  static_if<std::is_convertible<decltype(m), std::string>>(
+      [&w](const auto& m) {
+        w.write("\"label\":");
+        w.string(m, true);
+        w.put(',');
+      },
+      [](const auto&) {}, m);
+}
+
+template <class Axis>
+void write_json_axis(text_writer& w, const Axis& a) {
+  w.put('{');
+  write_text_label(w, a);
+  const auto opt = axis::traits::options(a);
+  w.write("\"underflow\":");
+  w.write(opt & axis::option::underflow ? "true" : "false");
+  w.write(",\"overflow\":");
+  w.write(opt & axis::option::overflow ? "true" : "false");
+  w.write(",\"size\":");
+  w.number(a.size(), true);
+  w.write(is_continuous(a) ? ",\"edges\":[" : ",\"values\":[");
+  bool first = true;
+  for_each_axis_value(a, [&w, &first](const auto& x) {
+    if (!first) w.put(',');
+    first = false;
+    write_text_value(w, x, true);
+  });
+  w.write("]}");
+}
+
+template <class... Ts>
+void write_json_axis(text_writer& w, const axis::variant<Ts...>& a) {
+  axis::visit([&w](const auto& a) { write_json_axis(w, a); }, a);
+}
+
+// Pre-formatted CSV fields for each bin of an axis, index -1 to size. Continuous axes
+// have the fields lower and upper edge, discrete axes have the bin value.
+struct csv_axis_fields {
+  bool continuous = false;
+  std::string text;
+  std::vector<std::size_t> offset;
+
+  template <class Axis>
+  explicit csv_axis_fields(const Axis& a) {
+    init(a);
+  }
+
+  template <class... Ts>
+  explicit csv_axis_fields(const axis::variant<Ts...>& a) {
+    axis::visit([this](const auto& a) { init(a); }, a);
+  }
+
+  template <class Axis>
+  void init(const Axis& a) {
+    // format all values in one pass and remember where each one ends
+    std::ostringstream os;
+    std::vector<std::size_t> end;
+    {
+      text_writer w(os, 1 << 16);
+      for_each_axis_value(a, [&w, &end](const auto& x) {
+        write_text_value(w, x, false);
+        end.push_back(w.tellp());
+      });
+      w.flush();
+    }
+    const auto values = os.str();
+    // append value i, or a custom string if i is out of range
+    const auto append = [this, &values, &end](std::size_t i, const char* alt) {
+      if (i < end.size()) {
+        const auto begin = i > 0 ? end[i - 1] : 0;
+        text.append(values, begin, end[i] - begin);
+      } else {
+        text += alt;
+      }
+    };
+    const auto next = [this] {
+      text += ',';
+      offset.push_back(text.size());
+    };
+
+    continuous = is_continuous(a);
+    const auto n = static_cast<std::size_t>(a.size());
+    text.reserve(values.size() * (continuous ? 2 : 1) + 2 * n + 16);
+    offset.reserve(n + 3);
+    offset.push_back(0);
+    if (continuous) {
+      // fields of bin i are the values i and i + 1, for i from -1 to size
+      for (std::size_t i = 0; i <= n + 1; ++i) {
+        append(i - 1, "-inf");
+        text += ',';
+        append(i, "inf");
+        next();
+      }
+    } else {
+      for (std::size_t i = 0; i <= n + 1; ++i) {
+        append(i - 1, "");
+        next();
+      }
+    }
+  }
+
+  void write(text_writer& w, axis::index_type i) const {
+    const auto k = static_cast<std::size_t>(i + 1);
+    w.write(text.data() + offset[k], offset[k + 1] - offset[k]);
+  }
+};
+
+} // namespace detail
+
+/** Save histogram in JSON format.
+
+  The output is a JSON object with the keys "axes" and "values". Each axis is an object
+  with its label, if the metadata is a string, flags for the presence of underflow and
+  overflow bins, the number of bins, and "values". These are the bin edges for axes
+  with continuous values, and the bin values otherwise. Cells follow in the order of
+  indexed(h, cov), the first axis varies fastest. Accumulators with a value and a
+  variance are written as pairs. Infinite and NaN values are written as null. With
+  coverage::nonzero, the cells cannot be located from their position, so the key
+  "indices" follows with the bin indices of each cell, see indexed().
+
+  @param os output stream.
+  @param h histogram.
+  @param cov iteration coverage (optional, default: inner).
+  @param chunk_size size of chunks in bytes which are written to the stream (optional).
+*/
+template <class A, class S>
+void save_json(std::ostream& os, const histogram<A, S>& h,
+               coverage cov = coverage::inner, std::size_t chunk_size = 1 << 16) {
+  using value_type = typename S::value_type;
+  detail::text_writer w(os, chunk_size);
+  w.write("{\"axes\":[");
+  unsigned n = 0;
+  h.for_each_axis([&w, &n](const auto& a) {
+    if (n++) w.put(',');
+    detail::write_json_axis(w, a);
+  });
+  w.write("],\"values\":[");
+  bool first = true;
+  const auto f = [&w, &first](const value_type& x) {
+    if (!first) w.put(',');
+    first = false;
+    detail::write_text_cell(w, x, true);
+  };
+  if (cov == coverage::all)
+    for (auto&& x : h) f(x);
+  else
+    for (auto&& x : indexed(h, cov)) f(*x);
+  if (cov == coverage::nonzero) {
+    w.write("],\"indices\":[");
+    first = true;
+    for (auto&& x : indexed(h, cov)) {
+      if (!first) w.put(',');
+      first = false;
+      w.put('[');
+      for (unsigned k = 0; k < h.rank(); ++k) {
+        if (k) w.put(',');
+        w.number(x.index(k), true);
+      }
+      w.put(']');
+    }
+  }
+  w.write("]}");
+  w.flush();
+}
+
+/** Save histogram in CSV format.
+
+  The output has a header line and one line for each cell in the order of
+  indexed(h, cov). For each axis with continuous values, there are two columns with the
+  lower and upper edge of the bin, named lower0 and upper0 for the first axis and so on.
+  The edges of underflow and overflow bins are -inf and inf. For other axes, there is one
+  column with the bin value, named bin0 and so on, which is empty for underflow and
+  overflow bins. The last column is the cell value. Accumulators with a value and a
+  variance are written as a quoted pair.
+
+  @param os output stream.
+  @param h histogram.
+  @param cov iteration coverage (optional, default: inner).
+  @param chunk_size size of chunks in bytes which are written to the stream (optional).
+*/
+template <class A, class S>
+void save_csv(std::ostream& os, const histogram<A, S>& h, coverage cov = coverage::inner,
+              std::size_t chunk_size = 1 << 16) {
+  using value_type = typename S::value_type;
+  std::vector<detail::csv_axis_fields> fields;
+  fields.reserve(h.rank());
+  h.for_each_axis([&fields](const auto& a) { fields.emplace_back(a); });
+
+  detail::text_writer w(os, chunk_size);
+  for (unsigned k = 0; k < fields.size(); ++k) {
+    const auto i = std::to_string(k);
+    w.write(fields[k].continuous ? "lower" + i + ",upper" + i + "," : "bin" + i + ",");
+  }
+  w.write("value\n");
+  for (auto&& x : indexed(h, cov)) {
+    for (unsigned k = 0; k < fields.size(); ++k) fields[k].write(w, x.index(k));
+    const value_type& v = *x;
+    detail::write_text_cell(w, v, false);
+    w.put('\n');
+  }
+  w.flush();
+}
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,155 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_HISTOGRAM_TRACKING_STORAGE_HPP
+#define BOOST_HISTOGRAM_TRACKING_STORAGE_HPP
+
+#include <algorithm>
+#include <boost/histogram/detail/iterator_adaptor.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/fwd.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/**
+  Storage which records when blocks of cells were last modified.
+
+  Cells are grouped into blocks of BlockSize consecutive cells. Each block carries the
+  generation in which it was last accessed for writing. A call to checkpoint() closes
+  the current generation, so that the blocks modified after a checkpoint can be found
+  with is_modified() without scanning the cells. This is used by save_delta() in
+  boost/histogram/binary.hpp to write only the blocks which changed.
+
+  Writes are detected conservatively: every access through the non-const operator[] or
+  by dereferencing a non-const iterator marks the block, even if the value is not
+  changed. Read-only access through a const storage does not mark blocks.
+
+  @tparam Storage underlying storage.
+  @tparam BlockSize number of cells per block, must be a power of two.
+*/
+template <class Storage, std::size_t BlockSize>
+class tracking_storage {
+  static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0,
+                "BlockSize must be a power of two");
+
+public:
+  // writing to the generation of a block is not thread-safe
+  static constexpr bool has_threading_support = false;
+  static constexpr std::size_t block_size = BlockSize;
+
+  using storage_type = Storage;
+  using value_type = typename Storage::value_type;
+  using reference = typename Storage::reference;
+  using const_reference = typename Storage::const_reference;
+  using generation_type = std::uint64_t;
+
+private:
+  template <class Value, class Reference, class Pointer>
+  class iterator_impl
+      : public detail::iterator_adaptor<iterator_impl<Value, Reference, Pointer>,
+                                        std::size_t, Reference, Value> {
+  public:
+    iterator_impl() = default;
+    template <class V, class R, class P>
+    iterator_impl(const iterator_impl<V, R, P>& it)
+        : iterator_impl::iterator_adaptor_(it.base()), s_(it.s_) {}
+    iterator_impl(Pointer s, std::size_t i) noexcept
+        : iterator_impl::iterator_adaptor_(i), s_(s) {}
+
+    Reference operator*() const { return (*s_)[this->base()]; }
+
+    template <class V, class R, class P>
+    friend class iterator_impl;
+
+  private:
+    Pointer s_ = nullptr;
+  };
+
+public:
+  using iterator = iterator_impl<value_type, reference, tracking_storage*>;
+  using const_iterator =
+      iterator_impl<const value_type, const_reference, const tracking_storage*>;
+
+  tracking_storage() = default;
+
+  /// Track existing storage, all cells are considered modified in the first generation.
+  explicit tracking_storage(Storage s) : storage_(std::move(s)) {
+    generations_.assign(block_count(), generation_);
+  }
+
+  /// Reset storage to n empty cells, all blocks are marked as modified.
+  void reset(std::size_t n) {
+    storage_.reset(n);
+    generations_.assign(block_count(), generation_);
+  }
+
+  std::size_t size() const noexcept { return storage_.size(); }
+
+  reference operator[](std::size_t i) {
+    generations_[i / BlockSize] = generation_;
+    return storage_[i];
+  }
+
+  const_reference operator[](std::size_t i) const { return storage_[i]; }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size()}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size()}; }
+
+  template <class U, class = detail::requires_iterable<U>>
+  bool operator==(const U& u) const {
+    using std::begin;
+    using std::end;
+    return std::equal(this->begin(), this->end(), begin(u), end(u), detail::equal{});
+  }
+
+  /// Return current generation, modified blocks are marked with this number.
+  generation_type generation() const noexcept { return generation_; }
+
+  /**
+    Close the current generation and return its number.
+
+    Blocks modified after this call satisfy is_modified(i, g), where g is the returned
+    number.
+  */
+  generation_type checkpoint() noexcept { return generation_++; }
+
+  /// Return number of blocks.
+  std::size_t block_count() const noexcept {
+    return (size() + BlockSize - 1) / BlockSize;
+  }
+
+  /// Return generation in which block i was last modified.
+  generation_type block_generation(std::size_t i) const noexcept {
+    return generations_[i];
+  }
+
+  /// Return true if block i was modified after the checkpoint which returned since.
+  bool is_modified(std::size_t i, generation_type since) const noexcept {
+    return generations_[i] > since;
+  }
+
+  /// Read-only access to the underlying storage.
+  const storage_type& base() const noexcept { return storage_; }
+
+private:
+  Storage storage_;
+  std::vector<generation_type> generations_;
+  generation_type generation_ = 1;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
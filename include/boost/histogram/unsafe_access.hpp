@@ -87,6 +87,13 @@ struct unsafe_access {
     return storage.buffer_;
   }
 
+  /// @copydoc unlimited_storage_buffer()
+  template <class Allocator>
+  static constexpr const auto& unlimited_storage_buffer(
+      const unlimited_storage<Allocator>& storage) {
+    return storage.buffer_;
+  }
+
   /**
     Get implementation of storage_adaptor.
     @param storage instance of storage_adaptor.
@@ -0,0 +1,149 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/algorithm/cumulative.hpp>
+#include <boost/histogram/axis/category.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/variable.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "is_close.hpp"
+#include "utility_histogram.hpp"
+#include "utility_meta.hpp"
+
+using namespace boost::histogram;
+using algorithm::cumulative;
+
+template <class Tag>
+void run_tests() {
+  // regular axis
+  {
+    auto h = make(Tag(), axis::regular<>(4, 0, 4));
+    h(0.5);
+    h(1.5, weight(2));
+    h(3.5);
+    h(-1);
+    h(10, weight(3));
+
+    const auto c = cumulative(h);
+    BOOST_TEST_EQ(c.edges(), (std::vector<double>{0, 1, 2, 3, 4}));
+    BOOST_TEST_EQ(c.values(), (std::vector<double>{0, 1, 3, 3, 4}));
+    BOOST_TEST_EQ(c.total(), 4);
+    BOOST_TEST_EQ(c.quantile(0), 0);
+    BOOST_TEST_EQ(c.quantile(0.125), 0.5);
+    BOOST_TEST_EQ(c.quantile(0.25), 1);
+    BOOST_TEST_EQ(c.quantile(0.5), 1.5);
+    BOOST_TEST_EQ(c.quantile(0.75), 2);
+    BOOST_TEST_EQ(c.quantile(0.875), 3.5);
+    BOOST_TEST_EQ(c.quantile(1), 4);
+    BOOST_TEST_THROWS((void)c.quantile(-0.1), std::invalid_argument);
+    BOOST_TEST_THROWS((void)c.quantile(1.1), std::invalid_argument);
+    BOOST_TEST_THROWS((void)c.quantile(std::nan("")), std::invalid_argument);
+
+    // with flow bins, quantiles in flow bins return the axis boundary
+    const auto call = cumulative(h, coverage::all);
+    BOOST_TEST_EQ(call.edges(), (std::vector<double>{0, 0, 1, 2, 3, 4, 4}));
+    BOOST_TEST_EQ(call.total(), 8);
+    BOOST_TEST_EQ(call.quantile(0), 0);
+    BOOST_TEST_EQ(call.quantile(0.125), 0);
+    BOOST_TEST_EQ(call.quantile(0.1875), 0.5);
+    BOOST_TEST_EQ(call.quantile(0.9), 4);
+  }
+
+  // leading empty bins are skipped for q = 0
+  {
+    auto h = make(Tag(), axis::integer<>(0, 5));
+    h(3);
+    const auto c = cumulative(h);
+    BOOST_TEST_EQ(c.quantile(0), 3);
+    BOOST_TEST_EQ(c.quantile(0.5), 3.5);
+    BOOST_TEST_EQ(c.quantile(1), 4);
+  }
+
+  // q * total underflows to zero for tiny q
+  {
+    auto h = make(Tag(), axis::integer<>(0, 5));
+    h(3, weight(0.25));
+    const auto c = cumulative(h);
+    BOOST_TEST_EQ(c.quantile(std::numeric_limits<double>::denorm_min()), 3);
+    BOOST_TEST_EQ(c.quantile(1), 4);
+  }
+
+  // variable axis with weighted storage
+  {
+    auto h = make_s(Tag(), weight_storage(), axis::variable<>({0, 1, 10, 100}));
+    h(0.5, weight(1));
+    h(5, weight(1));
+    h(50, weight(2));
+    const auto c = cumulative(h);
+    BOOST_TEST_EQ(c.quantile(0.25), 1);
+    BOOST_TEST_EQ(c.quantile(0.375), 5.5);
+    BOOST_TEST_EQ(c.quantile(0.75), 55);
+  }
+
+  // empty histogram
+  {
+    auto h = make(Tag(), axis::integer<>(0, 5));
+    BOOST_TEST(std::isnan(cumulative(h).quantile(0.5)));
+  }
+
+  // marginal distribution
+  {
+    auto h = make(Tag(), axis::integer<>(0, 2), axis::regular<>(2, 0, 1));
+    h(0, 0.25);
+    h(1, 0.25);
+    h(2, 0.75); // overflow of first axis is included in marginal
+    h(1, 0.75);
+    BOOST_TEST_THROWS((void)cumulative(h), std::invalid_argument);
+    BOOST_TEST_THROWS((void)cumulative(h, 2), std::invalid_argument);
+    const auto c0 = cumulative(h, 0);
+    BOOST_TEST_EQ(c0.values(), (std::vector<double>{0, 1, 3}));
+    const auto c1 = cumulative(h, 1);
+    BOOST_TEST_EQ(c1.values(), (std::vector<double>{0, 2, 4}));
+    BOOST_TEST_EQ(c1.quantile(0.5), 0.5);
+  }
+
+  // axis values not convertible to double
+  {
+    auto h = make(Tag(), axis::category<std::string>({"A", "B"}));
+    BOOST_TEST_THROWS((void)cumulative(h), std::runtime_error);
+  }
+
+  // cached quantile index
+  {
+    auto h = make(Tag(), axis::regular<>(10, 0, 10));
+    algorithm::quantile_index<decltype(h)> qi(h);
+    BOOST_TEST(std::isnan(qi.quantile(0.5)));
+    for (int i = 0; i < 10; ++i) qi(i + 0.5);
+    BOOST_TEST_IS_CLOSE(qi.quantile(0.5), 5, 1e-12);
+    BOOST_TEST_IS_CLOSE(qi.quantile(0.95), 9.5, 1e-12);
+    const auto* p = &qi.cumulative();
+    BOOST_TEST_EQ(&qi.cumulative(), p); // not recomputed
+    BOOST_TEST_EQ(qi.cumulative().total(), 10);
+
+    // modification not through index is not seen until invalidate()
+    for (int i = 0; i < 10; ++i) h(0.5);
+    BOOST_TEST_EQ(qi.cumulative().total(), 10);
+    qi.invalidate();
+    BOOST_TEST_EQ(qi.cumulative().total(), 20);
+    BOOST_TEST_IS_CLOSE(qi.quantile(0.55), 1, 1e-12);
+
+    using index_t = algorithm::quantile_index<decltype(h)>;
+    BOOST_TEST_THROWS(index_t(h, 1), std::invalid_argument);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
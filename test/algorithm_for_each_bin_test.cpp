@@ -0,0 +1,104 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/for_each_bin.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/span_storage.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <map>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using algorithm::for_each_bin;
+
+template <class Tag, class Policy>
+void run_tests(const Policy& policy) {
+  // modify cells
+  {
+    auto h = make(Tag(), axis::regular<>(100, 0, 1), axis::integer<>(0, 300));
+    for_each_bin(policy, h, [](auto&& x) { *x = x.index(0) + 1000 * x.index(1); });
+    for (auto&& x : indexed(h, coverage::all)) {
+      const bool inner = 0 <= x.index(0) && x.index(0) < 100 && 0 <= x.index(1) &&
+                         x.index(1) < 300;
+      BOOST_TEST_EQ(*x, inner ? x.index(0) + 1000 * x.index(1) : 0);
+    }
+
+    // read with concurrent accumulation
+    std::atomic<int> count(0), flow(0);
+    const auto& ch = h;
+    for_each_bin(
+        policy, ch,
+        [&](auto&& x) {
+          ++count;
+          if (x.index(0) == -1 || x.index(0) == 100) ++flow;
+        },
+        coverage::all);
+    BOOST_TEST_EQ(count, 102 * 302);
+    BOOST_TEST_EQ(flow, 2 * 302);
+  }
+
+  // sparse
+  {
+    auto h = make(Tag(), axis::integer<>(0, 1000), axis::integer<>(0, 100));
+    h(3, 4);
+    h(500, 50);
+    h(999, 99, weight(2));
+    h(2000, 0);
+    std::atomic<int> count(0);
+    std::atomic<long> sum(0);
+    for_each_bin(
+        policy, h,
+        [&](auto&& x) {
+          ++count;
+          sum += x.index(0);
+        },
+        coverage::nonzero);
+    BOOST_TEST_EQ(count, 4);
+    BOOST_TEST_EQ(sum, 3 + 500 + 999 + 1000);
+  }
+
+  // cells of span_storage are written concurrently into the external buffer
+  {
+    std::vector<int> mem(1002, 0);
+    auto h = make_s(Tag(), span_storage<int>(mem.data(), mem.size()),
+                    axis::integer<>(0, 1000));
+    for_each_bin(policy, h, [](auto&& x) { *x = x.index(); });
+    BOOST_TEST_EQ(mem[1], 0);
+    BOOST_TEST_EQ(mem[1000], 999);
+    BOOST_TEST_EQ(algorithm::sum(h), 999 * 1000 / 2);
+  }
+
+  // storages without independent writes are processed sequentially
+  {
+    auto h = make_s(Tag(), std::map<std::size_t, double>(), axis::integer<>(0, 200),
+                    axis::integer<>(0, 200));
+    for_each_bin(policy, h, [](auto&& x) {
+      if (x.index(0) == x.index(1)) *x = 1;
+    });
+    BOOST_TEST_EQ(algorithm::sum(h), 200);
+
+    auto h2 = make_s(Tag(), unlimited_storage<>(), axis::integer<>(0, 200),
+                     axis::integer<>(0, 200));
+    for_each_bin(policy, h2, [](auto&& x) { *x = x.index(0) * 1000; });
+    BOOST_TEST_EQ(h2.at(199, 3), 199000);
+  }
+}
+
+int main() {
+  run_tests<static_tag>(execution::seq);
+  run_tests<dynamic_tag>(execution::seq);
+  run_tests<static_tag>(execution::parallel_policy(4));
+  run_tests<dynamic_tag>(execution::parallel_policy(4));
+  run_tests<static_tag>(execution::par);
+
+  return boost::report_errors();
+}
@@ -0,0 +1,151 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/algorithm/merge.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using algorithm::merge;
+
+template <class Histogram, class Policy>
+void check_merge(const std::vector<Histogram>& hs, const Policy& policy) {
+  auto expected = hs.front();
+  for (auto it = hs.begin() + 1; it != hs.end(); ++it) expected += *it;
+  BOOST_TEST_EQ(merge(hs, policy), expected);
+}
+
+template <class Tag, class Storage, class Policy>
+void run_storage_tests(const Storage& s, const Policy& policy) {
+  // big enough for several tiles per thread
+  auto h = make_s(Tag(), s, axis::integer<>(0, 100), axis::regular<>(97, 0, 1));
+  std::vector<decltype(h)> hs(7, h);
+  for (unsigned k = 0; k < hs.size(); ++k)
+    for (unsigned i = 0; i < 100 * (k + 1); ++i)
+      hs[k](static_cast<int>(i % 100), (i % 97) / 97.0);
+  check_merge(hs, policy);
+
+  // single histogram
+  hs.resize(1);
+  BOOST_TEST_EQ(merge(hs, policy), hs.front());
+}
+
+template <class Tag, class Policy>
+void run_tests(const Policy& policy) {
+  run_storage_tests<Tag>(dense_storage<int>(), policy);
+  run_storage_tests<Tag>(dense_storage<double>(), policy);
+  run_storage_tests<Tag>(dense_storage<accumulators::weighted_sum<>>(), policy);
+  run_storage_tests<Tag>(std::map<std::size_t, double>(), policy);
+  run_storage_tests<Tag>(unlimited_storage<>(), policy);
+
+  // axes mismatch
+  {
+    auto h1 = make(Tag(), axis::integer<>(0, 2));
+    auto h2 = make(Tag(), axis::integer<>(0, 3));
+    std::vector<decltype(h1)> hs = {h1, h1};
+    hs[1] = h2;
+    BOOST_TEST_THROWS((void)merge(hs, policy), std::invalid_argument);
+  }
+
+  // empty range
+  {
+    std::vector<decltype(make(Tag(), axis::integer<>(0, 2)))> hs;
+    BOOST_TEST_THROWS((void)merge(hs, policy), std::invalid_argument);
+  }
+
+  // unlimited_storage is promoted once to a type which cannot overflow
+  {
+    auto h = make(Tag(), axis::integer<>(0, 2));
+    std::vector<decltype(h)> hs(3, h);
+    for (auto&& hi : hs) {
+      for (unsigned i = 0; i < 255; ++i) hi(0);
+      hi(1);
+    }
+    const auto m = merge(hs, policy);
+    BOOST_TEST_EQ(m.at(0), 3 * 255);
+    BOOST_TEST_EQ(m.at(1), 3);
+    BOOST_TEST_EQ(algorithm::sum(m), 3 * 256);
+    const auto& b = unsafe_access::unlimited_storage_buffer(unsafe_access::storage(m));
+    using buffer_type = std::decay_t<decltype(b)>;
+    BOOST_TEST_EQ(b.type, buffer_type::template type_index<std::uint16_t>());
+  }
+
+  // small values stay in uint8_t, promotion depends on values and not on type
+  {
+    auto h = make(Tag(), axis::integer<>(0, 2));
+    std::vector<decltype(h)> hs(3, h);
+    for (auto&& hi : hs) {
+      hi(0);
+      hi(1);
+    }
+    hs[0].at(1) = 200; // still uint8_t
+    const auto m = merge(hs, policy);
+    BOOST_TEST_EQ(m.at(0), 3);
+    BOOST_TEST_EQ(m.at(1), 202);
+    const auto& b = unsafe_access::unlimited_storage_buffer(unsafe_access::storage(m));
+    using buffer_type = std::decay_t<decltype(b)>;
+    BOOST_TEST_EQ(b.type, buffer_type::template type_index<std::uint8_t>());
+  }
+
+  // large values in different tiles do not add up
+  {
+    auto h = make(Tag(), axis::integer<>(0, 5000));
+    std::vector<decltype(h)> hs(2, h);
+    hs[0].at(0) = 200;
+    hs[1].at(4000) = 200;
+    hs[1](0);
+    const auto m = merge(hs, policy);
+    BOOST_TEST_EQ(m.at(0), 201);
+    BOOST_TEST_EQ(m.at(4000), 200);
+    const auto& b = unsafe_access::unlimited_storage_buffer(unsafe_access::storage(m));
+    using buffer_type = std::decay_t<decltype(b)>;
+    BOOST_TEST_EQ(b.type, buffer_type::template type_index<std::uint8_t>());
+  }
+
+  // overflow of uint64_t goes to large_int
+  {
+    auto h = make(Tag(), axis::integer<>(0, 1));
+    std::vector<decltype(h)> hs(2, h);
+    const auto big = std::numeric_limits<std::uint64_t>::max();
+    hs[0].at(0) = big;
+    hs[1].at(0) = 2;
+    const auto m = merge(hs, policy);
+    using large_int = unlimited_storage<>::large_int;
+    BOOST_TEST_EQ(m.at(0), static_cast<double>(big) + 2);
+    const auto& b = unsafe_access::unlimited_storage_buffer(unsafe_access::storage(m));
+    using buffer_type = std::decay_t<decltype(b)>;
+    BOOST_TEST_EQ(b.type, buffer_type::template type_index<large_int>());
+  }
+
+  // double in any input turns result into double
+  {
+    auto h = make(Tag(), axis::integer<>(0, 1));
+    std::vector<decltype(h)> hs(3, h);
+    hs[0](0);
+    hs[1].at(0) = 0.5;
+    hs[2](0);
+    BOOST_TEST_EQ(merge(hs, policy).at(0), 2.5);
+  }
+}
+
+int main() {
+  run_tests<static_tag>(execution::seq);
+  run_tests<dynamic_tag>(execution::seq);
+  run_tests<static_tag>(execution::par);
+  run_tests<dynamic_tag>(execution::par);
+  run_tests<static_tag>(execution::parallel_policy(3));
+  run_tests<dynamic_tag>(execution::parallel_policy(3));
+
+  return boost::report_errors();
+}
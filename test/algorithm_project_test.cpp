@@ -5,6 +5,7 @@
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/mean.hpp>
 #include <boost/histogram/algorithm/project.hpp>
 #include <boost/histogram/algorithm/sum.hpp>
 #include <boost/histogram/axis/integer.hpp>
@@ -176,6 +177,28 @@ void run_tests() {
     x = {0, 0};
     BOOST_TEST_THROWS((void)project(h, x), std::invalid_argument);
   }
+
+  // projection of profile with empty cells
+  {
+    auto h = make_s(Tag(), profile_storage(), axis::integer<>(0, 2),
+                    axis::integer<>(0, 2));
+    h(0, 0, sample(1));
+    h(0, 1, sample(3));
+    h(1, 0, sample(5));
+
+    auto hx = project(h, 0_c);
+    BOOST_TEST_EQ(hx.at(-1).count(), 0);
+    BOOST_TEST_EQ(hx.at(0).count(), 2);
+    BOOST_TEST_EQ(hx.at(0).value(), 2);
+    BOOST_TEST_EQ(hx.at(1).count(), 1);
+    BOOST_TEST_EQ(hx.at(1).value(), 5);
+
+    auto hy = project(h, 1_c);
+    BOOST_TEST_EQ(hy.at(0).count(), 2);
+    BOOST_TEST_EQ(hy.at(0).value(), 3);
+    BOOST_TEST_EQ(hy.at(1).count(), 1);
+    BOOST_TEST_EQ(hy.at(1).value(), 3);
+  }
 }
 
 int main() {
@@ -0,0 +1,159 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/auto_range_histogram.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace boost::histogram;
+
+int main() {
+  // bad arguments
+  {
+    BOOST_TEST_THROWS(auto_range_histogram<>(0, 10), std::invalid_argument);
+    BOOST_TEST_THROWS(auto_range_histogram<>(4, 0), std::invalid_argument);
+    BOOST_TEST_THROWS(auto_range_histogram<>(4, 10, 0.5, 0.5), std::invalid_argument);
+    BOOST_TEST_THROWS(auto_range_histogram<>(4, 10, -0.1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(auto_range_histogram<>(4, 10, 0, 1.1), std::invalid_argument);
+  }
+
+  // range is min and max of buffered values
+  {
+    auto h = auto_range_histogram<>(4, 5, 0, 1, "foo");
+    h(2.2);
+    h(1);
+    h(3.2);
+    h(5);
+    BOOST_TEST_NOT(h.frozen());
+    BOOST_TEST_EQ(h.buffered(), 4);
+    h(4.2);
+    BOOST_TEST(h.frozen());
+    BOOST_TEST_EQ(h.buffered(), 0);
+    h(0);
+    h(6);
+    h(1.5);
+
+    const auto& hh = h.get();
+    const auto& a = hh.axis();
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    BOOST_TEST_EQ(a.size(), 4);
+    BOOST_TEST_EQ(a.value(0), 1);
+    BOOST_TEST_GE(a.value(4), 5);
+    BOOST_TEST_LT(a.value(4), 5 + 1e-12);
+    BOOST_TEST_EQ(hh.at(-1), 1);
+    BOOST_TEST_EQ(hh.at(0), 2);
+    BOOST_TEST_EQ(hh.at(1), 1);
+    BOOST_TEST_EQ(hh.at(2), 1);
+    BOOST_TEST_EQ(hh.at(3), 2);
+    BOOST_TEST_EQ(hh.at(4), 1);
+  }
+
+  // freeze before buffer is full, NaN is ignored for range
+  {
+    auto h = auto_range_histogram<>(2, 100);
+    h(std::numeric_limits<double>::quiet_NaN());
+    h(-1);
+    h(1);
+    auto& hh = h.get();
+    BOOST_TEST(h.frozen());
+    BOOST_TEST_EQ(hh.axis().value(0), -1);
+    BOOST_TEST_EQ(hh.at(0), 1);
+    BOOST_TEST_EQ(hh.at(1), 1);
+    BOOST_TEST_EQ(hh.at(2), 1);
+    h.freeze(); // no effect
+    BOOST_TEST_EQ(algorithm::sum(h.get()), 3);
+  }
+
+  // degenerate and empty buffers
+  {
+    auto h1 = auto_range_histogram<>(3, 3);
+    h1(2);
+    h1(2);
+    h1(2);
+    BOOST_TEST_EQ(h1.get().axis().value(0), 1.5);
+    BOOST_TEST_EQ(h1.get().axis().value(3), 2.5);
+    BOOST_TEST_EQ(h1.get().at(1), 3);
+
+    auto h2 = auto_range_histogram<>(2, 3);
+    h2(std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(h2.get().axis().value(0), 0);
+    BOOST_TEST_EQ(h2.get().axis().value(2), 1);
+    BOOST_TEST_EQ(h2.get().at(2), 1);
+
+    auto h3 = auto_range_histogram<>(2, 3);
+    BOOST_TEST_EQ(algorithm::sum(h3.get()), 0);
+
+    // x + 0.5 == x, range is widened by a few ulp
+    auto h4 = auto_range_histogram<>(2, 3);
+    h4(1.7e18);
+    BOOST_TEST_LT(h4.get().axis().value(0), 1.7e18);
+    BOOST_TEST_GT(h4.get().axis().value(2), 1.7e18);
+    BOOST_TEST_EQ(h4.get().at(1), 1);
+
+    const auto max = std::numeric_limits<double>::max();
+    auto h5 = auto_range_histogram<>(2, 3);
+    h5(max);
+    BOOST_TEST_LT(h5.get().axis().value(0), max);
+    BOOST_TEST_EQ(h5.get().axis().value(2), max);
+    BOOST_TEST_EQ(algorithm::sum(h5.get()), 1);
+  }
+
+  // width of range is larger than largest double
+  {
+    auto h = auto_range_histogram<>(4, 3);
+    h(-1e308);
+    h(0);
+    h(1e308);
+    const auto& a = h.get().axis();
+    BOOST_TEST_LT(a.value(0), 0);
+    BOOST_TEST_GT(a.value(4), 0);
+    BOOST_TEST_EQ(h.get().at(-1), 1);
+    BOOST_TEST_EQ(h.get().at(1) + h.get().at(2), 1);
+    BOOST_TEST_EQ(h.get().at(4), 1);
+
+    // range fits into double, but upper edge cannot be widened past it
+    auto h2 = auto_range_histogram<>(2, 2);
+    h2(0);
+    h2(std::numeric_limits<double>::max());
+    BOOST_TEST_EQ(h2.get().axis().value(0), 0);
+    BOOST_TEST_EQ(algorithm::sum(h2.get()), 2);
+  }
+
+  // quantiles cut tails, batch fill gives same result as single fills
+  {
+    std::mt19937 gen(1);
+    std::normal_distribution<> dis;
+    std::vector<double> v(10000);
+    for (auto&& x : v) x = dis(gen);
+
+    using A = axis::regular<double, use_default, axis::null_type>;
+    using S = dense_storage<int>;
+    auto h1 = auto_range_histogram<A, S>(20, 1000, 0.01, 0.99);
+    auto h2 = auto_range_histogram<A, S>(20, 1000, 0.01, 0.99);
+    for (auto&& x : v) h1(x);
+    h2.fill(std::vector<double>(v.begin(), v.begin() + 10));
+    h2.fill(std::vector<double>(v.begin() + 10, v.end()));
+
+    BOOST_TEST(h1.get() == h2.get());
+    const auto& a = h1.get().axis();
+    BOOST_TEST_GT(a.value(0), -3);
+    BOOST_TEST_LT(a.value(0), -2);
+    BOOST_TEST_GT(a.value(20), 2);
+    BOOST_TEST_LT(a.value(20), 3);
+    BOOST_TEST_EQ(algorithm::sum(h1.get()), 10000);
+    BOOST_TEST_GT(h1.get().at(-1), 0);
+    BOOST_TEST_GT(h1.get().at(20), 0);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,157 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/any.hpp>
+#include <boost/histogram/axis/category.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/variable.hpp>
+#include <boost/histogram/axis/variant.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+int main() {
+  // basic interface
+  {
+    axis::any<> a = axis::integer<double>(0, 2, "foo");
+    BOOST_TEST_EQ(a.size(), 2);
+    BOOST_TEST_EQ(a.options(), axis::option::underflow | axis::option::overflow);
+    BOOST_TEST_EQ(a.index(-10), -1);
+    BOOST_TEST_EQ(a.index(0.5), 0);
+    BOOST_TEST_EQ(a.index(1), 1);
+    BOOST_TEST_EQ(a.index(10), 2);
+    BOOST_TEST_EQ(a.value(1), 1);
+    BOOST_TEST_EQ(a.bin(0).lower(), 0);
+    BOOST_TEST_EQ(a.bin(0).upper(), 1);
+    BOOST_TEST_EQ(a.bin(-1).lower(), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    a.metadata() = "bar";
+    BOOST_TEST_EQ(a.metadata(), "bar");
+    test_axis_iterator(a, 0, 2);
+
+    a = axis::category<>({3, 1, 2});
+    BOOST_TEST_EQ(a.size(), 3);
+    BOOST_TEST_EQ(a.options(), axis::option::overflow);
+    BOOST_TEST_EQ(a.index(1), 1);
+    BOOST_TEST_EQ(a.index(4), 3);
+    BOOST_TEST_EQ(a.value(0), 3);
+    BOOST_TEST_EQ(a.bin(0).lower(), 3);
+    BOOST_TEST_EQ(a.bin(0).upper(), 3);
+    BOOST_TEST(a.bin(0).is_discrete());
+
+    // axis with other metadata type
+    a = axis::regular<double, axis::transform::id, axis::null_type>(2, 0, 1);
+    BOOST_TEST_THROWS(a.metadata(), std::runtime_error);
+  }
+
+  // copy, move, equal
+  {
+    axis::any<> a = axis::regular<>(2, 0, 1, "foo");
+    axis::any<> b;
+    BOOST_TEST(a != b);
+    b = a;
+    BOOST_TEST(a == b);
+    BOOST_TEST(b == axis::regular<>(2, 0, 1, "foo"));
+    BOOST_TEST(b != axis::regular<>(2, 0, 1, "bar"));
+    BOOST_TEST(b != axis::integer<>(0, 2, "foo"));
+    b.metadata() = "bar";
+    BOOST_TEST(a != b);
+    axis::any<> c(std::move(b));
+    BOOST_TEST(c == axis::regular<>(2, 0, 1, "bar"));
+    BOOST_TEST(b == axis::any<>());
+    c = std::move(a);
+    BOOST_TEST(c == axis::regular<>(2, 0, 1, "foo"));
+    c = axis::integer<>(0, 2, "foo");
+    BOOST_TEST(c != axis::regular<>(2, 0, 1, "foo"));
+  }
+
+  // get and get_if
+  {
+    axis::any<> a = axis::integer<>(1, 3);
+    BOOST_TEST(axis::get_if<axis::regular<>>(&a) == nullptr);
+    BOOST_TEST(axis::get_if<axis::integer<>>(&a) != nullptr);
+    const auto& ca = a;
+    BOOST_TEST_EQ(axis::get<axis::integer<>>(ca).value(0), 1);
+    BOOST_TEST_THROWS(axis::get<axis::regular<>>(a), std::runtime_error);
+    axis::get<axis::integer<>>(a).metadata() = "foo";
+    BOOST_TEST_EQ(a.metadata(), "foo");
+  }
+
+  // histogram with any axes gives same result as histogram with variant axes
+  {
+    using V = axis::variant<axis::regular<>, axis::variable<>, axis::category<>>;
+    auto h1 = make_histogram(std::vector<V>{axis::regular<>(3, 0, 1),
+                                            axis::variable<>({0.0, 0.5, 1.0}),
+                                            axis::category<>({1, 3, 5})});
+    auto h2 = make_histogram(std::vector<axis::any<>>{axis::regular<>(3, 0, 1),
+                                                      axis::variable<>({0.0, 0.5, 1.0}),
+                                                      axis::category<>({1, 3, 5})});
+    for (int i = 0; i < 20; ++i) {
+      const double x = 0.07 * i - 0.1;
+      h1(x, 1 - x, i % 6);
+      h2(x, 1 - x, i % 6);
+    }
+    BOOST_TEST_EQ(algorithm::sum(h2), 20);
+    for (auto&& x : indexed(h1, coverage::all)) {
+      const auto ind = x.indices();
+      BOOST_TEST_EQ(*x, h2.at(ind[0], ind[1], ind[2]));
+    }
+    BOOST_TEST(h2.axis(2) == axis::category<>({1, 3, 5}));
+
+    auto h3 = algorithm::reduce(h2, algorithm::shrink(0, 0, 2 / 3.0));
+    BOOST_TEST_EQ(h3.axis(0).size(), 2);
+    BOOST_TEST_EQ(h3.at(0, 0, 0), h2.at(0, 0, 0));
+    BOOST_TEST_THROWS(algorithm::reduce(h2, algorithm::shrink(2, 0, 1)),
+                      std::invalid_argument);
+  }
+
+  // axes without growth option, single values and columns give the same result
+  {
+    auto h1 = make_histogram(
+        std::vector<axis::any<>>{axis::regular<>(3, 0, 1), axis::integer<>(0, 2)});
+    auto h2 = h1;
+    const std::vector<double> x = {-0.1, 0.2, 0.5, 0.5, 0.9, 1.1};
+    const std::vector<double> y = {0, 1, 1, 2, -1, 0};
+    for (std::size_t i = 0; i < x.size(); ++i) h1(x[i], y[i]);
+    h2.fill(std::vector<std::vector<double>>{x, y});
+    BOOST_TEST(h1 == h2);
+    BOOST_TEST_EQ(h1.at(-1, 0), 1);
+    BOOST_TEST_EQ(h1.at(1, 1), 1);
+    BOOST_TEST_EQ(h1.at(1, 2), 1);
+    BOOST_TEST_EQ(h1.at(3, 0), 1);
+    BOOST_TEST_EQ(algorithm::sum(h1), 6);
+    BOOST_TEST_THROWS(h1(std::string("a"), 0), std::invalid_argument);
+  }
+
+  // growing axis
+  {
+    using growing = axis::regular<double, axis::transform::id, axis::null_type,
+                                  axis::option::growth_t>;
+    auto h = make_histogram(std::vector<axis::any<axis::null_type>>{
+        growing(1, 0, 1), axis::integer<int, axis::null_type>(0, 2)});
+    h(0.5, 0);
+    h(1.5, 1);
+    h(-0.5, 5);
+    BOOST_TEST_EQ(h.axis(0).size(), 3);
+    BOOST_TEST_EQ(h.at(1, 0), 1);
+    BOOST_TEST_EQ(h.at(2, 1), 1);
+    BOOST_TEST_EQ(h.at(0, 2), 1);
+    BOOST_TEST_EQ(algorithm::sum(h), 3);
+  }
+
+  return boost::report_errors();
+}
@@ -6,14 +6,28 @@
 
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/category.hpp>
+#include <boost/histogram/axis/traits.hpp>
 #include <boost/histogram/detail/throw_exception.hpp>
+#include <cstddef>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
 
+// string-like type which cannot be copied, like a view into a buffer
+struct string_ref {
+  string_ref(const char* s, std::size_t n) : s_(s), n_(n) {}
+  string_ref(const string_ref&) = delete;
+  const char* data() const { return s_; }
+  std::size_t size() const { return n_; }
+  const char* s_;
+  std::size_t n_;
+};
+
 int main() {
   // bad_ctors
   {
@@ -64,6 +78,31 @@ int main() {
     BOOST_TEST_EQ(a.size(), 3);
   }
 
+  // axis::category<std::string> with string-like arguments
+  {
+    axis::category<std::string> a({"A", "BC", ""});
+    BOOST_TEST_EQ(a.index("A"), 0);
+    BOOST_TEST_EQ(a.index("BC"), 1);
+    BOOST_TEST_EQ(a.index(""), 2);
+    BOOST_TEST_EQ(a.index("B"), 3);
+    BOOST_TEST_EQ(a.index(std::string("BC")), 1);
+    const char buf[] = "ABCD";
+    BOOST_TEST_EQ(a.index(string_ref(buf, 1)), 0);
+    BOOST_TEST_EQ(a.index(string_ref(buf + 1, 2)), 1);
+    BOOST_TEST_EQ(a.index(string_ref(buf + 1, 1)), 3);
+    BOOST_TEST_EQ(a.index(string_ref(buf, 0)), 2);
+    BOOST_TEST_EQ(axis::traits::index(a, "BC"), 1);
+
+    axis::category<std::string, axis::null_type, axis::option::growth_t> b;
+    BOOST_TEST_EQ(b.update(string_ref(buf + 1, 2)), std::make_pair(0, -1));
+    BOOST_TEST_EQ(b.update("BC"), std::make_pair(0, 0));
+    BOOST_TEST_EQ(b.update(string_ref(buf, 4)), std::make_pair(1, -1));
+    BOOST_TEST_EQ(b.size(), 2);
+    BOOST_TEST_EQ(b.value(0), "BC");
+    BOOST_TEST_EQ(b.value(1), "ABCD");
+    BOOST_TEST_EQ(axis::traits::update(b, "ABCD"), std::make_pair(1, 0));
+  }
+
   // iterators
   {
     test_axis_iterator(axis::category<>({3, 1, 2}, ""), 0, 3);
@@ -0,0 +1,85 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/interned_string.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <sstream>
+#include <string>
+
+using namespace boost::histogram;
+using axis::interned_string;
+
+template <class T>
+auto str(const T& t) {
+  std::ostringstream os;
+  os << t;
+  return os.str();
+}
+
+int main() {
+  auto& pool = detail::interned_string_pool::instance();
+  const auto pool_size = pool.size();
+
+  // construction, copy, comparison
+  {
+    interned_string a;
+    BOOST_TEST(a.empty());
+    BOOST_TEST_EQ(a.str(), "");
+    BOOST_TEST_EQ(a, interned_string(""));
+
+    interned_string b("foo");
+    interned_string c(std::string("foo"));
+    BOOST_TEST_EQ(pool.size(), pool_size + 1);
+    BOOST_TEST_EQ(b, c);
+    BOOST_TEST_EQ(b.c_str(), c.c_str()); // one shared copy
+    BOOST_TEST_EQ(b.str(), "foo");
+    BOOST_TEST_NE(b, a);
+    BOOST_TEST_NE(b, interned_string("bar"));
+
+    auto d = b;
+    BOOST_TEST_EQ(d, b);
+    b = a;
+    BOOST_TEST_EQ(d.str(), "foo");
+    BOOST_TEST_EQ(str(d), "foo");
+  }
+  // strings are removed from the pool with the last copy
+  BOOST_TEST_EQ(pool.size(), pool_size);
+
+  // string is interned again after it was removed
+  {
+    interned_string("foo");
+    BOOST_TEST_EQ(pool.size(), pool_size);
+    interned_string a("foo");
+    BOOST_TEST_EQ(a.str(), "foo");
+    BOOST_TEST_EQ(pool.size(), pool_size + 1);
+  }
+
+  // as axis metadata
+  {
+    using reg = axis::regular<double, use_default, interned_string>;
+    reg a(2, 0, 1, "x");
+    reg b(2, 0, 1, std::string("x"));
+    BOOST_TEST_EQ(a, b);
+    BOOST_TEST_NE(a, reg(2, 0, 1, "y"));
+    BOOST_TEST_EQ(a.metadata().c_str(), b.metadata().c_str());
+    BOOST_TEST_EQ(str(a),
+                  "regular(2, 0, 1, metadata=\"x\", options=underflow | overflow)");
+
+    auto h1 = make_histogram(a, axis::integer<int, interned_string>(0, 2, "y"));
+    h1(0.5, 1);
+    auto h2 = h1;
+    BOOST_TEST_EQ(h2.axis(0).metadata().c_str(), a.metadata().c_str());
+    auto h3 = h1 + h2;
+    BOOST_TEST_EQ(h3.at(1, 1), 2);
+  }
+  BOOST_TEST_EQ(pool.size(), pool_size);
+
+  return boost::report_errors();
+}
@@ -0,0 +1,193 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/axis/log_linear.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+template <class T>
+auto str(const T& t) {
+  std::ostringstream os;
+  os << t;
+  return os.str();
+}
+
+// every bin edge is mapped to its bin and the largest value below to the previous bin
+template <class Axis>
+void test_edges(const Axis& a, double precision) {
+  for (int i = 0; i < a.size(); ++i) {
+    using V = decltype(a.bin(i).lower());
+    const auto lower = a.value(i);
+    const auto upper = a.value(i + 1);
+    BOOST_TEST_EQ(a.index(lower), i);
+    BOOST_TEST_EQ(a.index(std::nextafter(upper, V(0))), i);
+    BOOST_TEST_LE((upper - lower) / lower, precision);
+  }
+}
+
+int main() {
+  // bad_ctor
+  {
+    BOOST_TEST_THROWS(axis::log_linear<>(0, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(16, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<float>(7, 1, 2), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(1, 2, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(1, -1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<>(1, 0, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<float>(1, 0, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(
+        axis::log_linear<>(1, 1, std::numeric_limits<double>::infinity()),
+        std::invalid_argument);
+    BOOST_TEST_THROWS(axis::log_linear<int>(1, -1, 1), std::invalid_argument);
+    BOOST_TEST_EQ(axis::log_linear<unsigned>(1, 0, 16).value(0), 0);
+    // many digits are fine if the range is narrow
+    const auto fine = axis::log_linear<>(12, 1, 1 + 1e-9);
+    BOOST_TEST_EQ(fine.bins_per_octave(), std::uint64_t{1} << 40);
+    BOOST_TEST_EQ(fine.value(0), 1);
+  }
+
+  // axis::log_linear with double
+  {
+    axis::log_linear<> a{1, 1, 4, "foo"};
+    BOOST_TEST_EQ(a.bins_per_octave(), 16);
+    BOOST_TEST_EQ(a.size(), 32);
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    BOOST_TEST_EQ(a.value(0), 1);
+    BOOST_TEST_EQ(a.value(1), 1.0625);
+    BOOST_TEST_EQ(a.value(16), 2);
+    BOOST_TEST_EQ(a.value(17), 2.125);
+    BOOST_TEST_EQ(a.value(16.5), 2.0625);
+    BOOST_TEST_EQ(a.value(32), 4);
+    BOOST_TEST_EQ(a.value(-1), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.value(33), std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.bin(16).lower(), 2);
+    BOOST_TEST_EQ(a.bin(16).upper(), 2.125);
+    BOOST_TEST_EQ(a.index(-1), -1);
+    BOOST_TEST_EQ(a.index(-0.0), -1);
+    BOOST_TEST_EQ(a.index(0), -1);
+    BOOST_TEST_EQ(a.index(0.99), -1);
+    BOOST_TEST_EQ(a.index(1), 0);
+    BOOST_TEST_EQ(a.index(1.07), 1);
+    BOOST_TEST_EQ(a.index(2), 16);
+    BOOST_TEST_EQ(a.index(3.99), 31);
+    BOOST_TEST_EQ(a.index(4), 32);
+    BOOST_TEST_EQ(a.index(1e300), 32);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 32);
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 32);
+    BOOST_TEST_EQ(str(a), "log_linear(32, 1, 4, bins_per_octave=16, metadata=\"foo\", "
+                          "options=underflow | overflow)");
+    BOOST_TEST_EQ(axis::traits::width(a, 16), 0.125);
+    BOOST_TEST(axis::traits::is_reducible<axis::log_linear<>>::value);
+
+    axis::log_linear<> b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    BOOST_TEST_NE(a, axis::log_linear<>(2, 1, 4, "foo"));
+    BOOST_TEST_NE(a, axis::log_linear<>(1, 1, 8, "foo"));
+    test_axis_iterator(a, 0, a.size());
+    test_edges(a, 0.1);
+  }
+
+  // range is extended to the nearest bin edges
+  {
+    axis::log_linear<> a{1, 1.01, 3.9};
+    BOOST_TEST_EQ(a.value(0), 1);
+    BOOST_TEST_EQ(a.value(a.size()), 4);
+    axis::log_linear<> b{1, 1.01, 3.875};
+    BOOST_TEST_EQ(b.value(b.size()), 3.875);
+  }
+
+  // subnormal numbers and zero
+  {
+    axis::log_linear<> a{2, 0.25, 1};
+    BOOST_TEST_EQ(a.index(0), -1);
+    BOOST_TEST_EQ(a.index(-0.0), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::denorm_min()), -1);
+    BOOST_TEST_EQ(a.index(0.5), a.size() - 128);
+    BOOST_TEST_EQ(a.index(1), a.size());
+
+    const auto tiny = std::numeric_limits<double>::denorm_min();
+    axis::log_linear<> b{1, tiny, 1};
+    // first bin contains zero, because it is the largest bin edge <= start
+    BOOST_TEST_EQ(b.value(0), 0);
+    BOOST_TEST_EQ(b.index(0), 0);
+    BOOST_TEST_EQ(b.index(-0.0), 0);
+    BOOST_TEST_EQ(b.index(tiny), 0);
+    BOOST_TEST_EQ(b.index(0.5), b.size() - 16);
+  }
+
+  // precision for several digits and value types
+  {
+    test_edges(axis::log_linear<>(3, 1e-6, 1e3), 1e-3);
+    test_edges(axis::log_linear<float>(3, 1e-6f, 1e3f), 1e-3);
+    test_edges(axis::log_linear<>(5, 0.1, 10), 1e-5);
+  }
+
+  // axis::log_linear with integers, bins below 2^m have unit width
+  {
+    axis::log_linear<int> a{1, 0, 100};
+    BOOST_TEST_EQ(a.size(), 57);
+    BOOST_TEST_EQ(a.value(0), 0);
+    BOOST_TEST_EQ(a.value(31), 31);
+    BOOST_TEST_EQ(a.value(32), 32);
+    BOOST_TEST_EQ(a.value(33), 34);
+    BOOST_TEST_EQ(a.value(48), 64);
+    BOOST_TEST_EQ(a.value(57), 100);
+    BOOST_TEST_EQ(a.index(-5), -1);
+    BOOST_TEST_EQ(a.index(0), 0);
+    BOOST_TEST_EQ(a.index(17), 17);
+    BOOST_TEST_EQ(a.index(31), 31);
+    BOOST_TEST_EQ(a.index(32), 32);
+    BOOST_TEST_EQ(a.index(33), 32);
+    BOOST_TEST_EQ(a.index(34), 33);
+    BOOST_TEST_EQ(a.index(99), 56);
+    BOOST_TEST_EQ(a.index(100), 57);
+    BOOST_TEST_EQ(axis::traits::width(a, 33), 2);
+
+    axis::log_linear<std::uint64_t> b{3, 1000, std::uint64_t{1} << 40};
+    BOOST_TEST_EQ(b.index(std::numeric_limits<std::uint64_t>::max()), b.size());
+    for (int i = 0; i < b.size(); ++i) {
+      const auto lower = static_cast<std::uint64_t>(b.value(i));
+      const auto upper = static_cast<std::uint64_t>(b.value(i + 1));
+      BOOST_TEST_EQ(b.index(lower), i);
+      BOOST_TEST_EQ(b.index(upper - 1), i);
+      BOOST_TEST_LE(double(upper - lower) / lower, 1e-3);
+    }
+  }
+
+  // reduce
+  {
+    auto h = make_histogram(axis::log_linear<>(1, 1, 4));
+    h(1.5);
+    h(2.5);
+    auto h2 = algorithm::reduce(h, algorithm::shrink(2, 4));
+    BOOST_TEST_EQ(h2.axis().value(0), 2);
+    BOOST_TEST_EQ(h2.axis().size(), 16);
+    BOOST_TEST_EQ(h2.axis().index(2.5), h.axis().index(2.5) - 16);
+    BOOST_TEST_EQ(h2.at(-1), 1);
+    BOOST_TEST_EQ(h2.at(h2.axis().index(2.5)), 1);
+    auto h3 = algorithm::reduce(h, algorithm::slice(3, 5));
+    BOOST_TEST_EQ(h3.axis().value(0), h.axis().value(3));
+    BOOST_TEST_EQ(h3.axis().value(2), h.axis().value(5));
+    BOOST_TEST_THROWS(algorithm::reduce(h, algorithm::rebin(2)), std::invalid_argument);
+  }
+
+  return boost::report_errors();
+}
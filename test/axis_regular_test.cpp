@@ -7,14 +7,92 @@
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/regular.hpp>
 #include <boost/histogram/detail/throw_exception.hpp>
+#include <cmath>
 #include <limits>
+#include <random>
 #include <sstream>
+#include <vector>
 #include "is_close.hpp"
 #include "utility_axis.hpp"
 
 using namespace boost::histogram;
 namespace tr = axis::transform;
 
+// reference implementation of the index computation with a division
+template <class T, class Tr>
+int index_by_division(const Tr& tr, int n, T start, T stop, T x) {
+  const T min = tr.forward(start);
+  const T z = (tr.forward(x) - min) / (tr.forward(stop) - min);
+  if (z < 1) return z >= 0 ? static_cast<int>(z * n) : -1;
+  return n;
+}
+
+// test values at and a few ulps around every bin edge and random values
+template <class T, class Tr = tr::id>
+void test_index_by_division(int n, T start, T stop, Tr tr = {}) {
+  const axis::regular<T, Tr, axis::null_type> a(tr, n, start, stop);
+  const auto inf = std::numeric_limits<T>::infinity();
+  std::vector<T> values;
+  for (int i = 0; i <= n; ++i) {
+    auto x = a.value(i);
+    for (int k = 0; k < 4; ++k) x = std::nextafter(x, -inf);
+    for (int k = 0; k < 9; ++k) {
+      values.push_back(x);
+      x = std::nextafter(x, inf);
+    }
+  }
+  std::mt19937 gen(1);
+  const auto d = stop - start;
+  std::uniform_real_distribution<T> dist(std::fmin(start, stop) - T(0.1) * std::fabs(d),
+                                         std::fmax(start, stop) + T(0.1) * std::fabs(d));
+  for (int i = 0; i < 10000; ++i) values.push_back(dist(gen));
+  std::vector<axis::index_type> indices(values.size());
+  a.index_n(values.data(), values.size(), indices.data());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const auto x = values[i];
+    BOOST_TEST_EQ(a.index(x), index_by_division(tr, n, start, stop, x));
+    BOOST_TEST_EQ(indices[i], a.index(x));
+  }
+}
+
+// circular axis: values around edges in several periods, random and huge values
+template <class T>
+void test_circular_index_by_division(int n, T start, T stop) {
+  const axis::circular<T, axis::null_type> a(n, start, stop);
+  const auto inf = std::numeric_limits<T>::infinity();
+  const auto d = stop - start;
+  std::vector<T> values = {inf, -inf, std::numeric_limits<T>::quiet_NaN(), T(1e30),
+                           T(-1e30)};
+  for (int p = -3; p <= 3; ++p) {
+    for (int i = 0; i <= n; ++i) {
+      auto x = a.value(i) + p * d;
+      for (int k = 0; k < 4; ++k) x = std::nextafter(x, -inf);
+      for (int k = 0; k < 9; ++k) {
+        values.push_back(x);
+        x = std::nextafter(x, inf);
+      }
+    }
+  }
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<T> dist(start - 10 * d, stop + 10 * d);
+  for (int i = 0; i < 10000; ++i) values.push_back(dist(gen));
+  std::uniform_real_distribution<T> wide(T(-1e9) * d, T(1e9) * d);
+  for (int i = 0; i < 1000; ++i) values.push_back(wide(gen));
+  std::vector<axis::index_type> indices(values.size());
+  a.index_n(values.data(), values.size(), indices.data());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const auto x = values[i];
+    auto z = (x - start) / d;
+    auto ref = n;
+    if (std::isfinite(z)) {
+      z -= std::floor(z);
+      ref = static_cast<int>(z * n);
+    }
+    BOOST_TEST_EQ(a.index(x), ref);
+    BOOST_TEST_EQ(indices[i], ref);
+  }
+}
+
 int main() {
   using def = use_default;
 
@@ -194,6 +272,64 @@ int main() {
                   std::make_pair(-1, 0));
   }
 
+  // index computed by multiplication is identical to the one computed by division
+  {
+    test_index_by_division(4, -2.0, 2.0);
+    test_circular_index_by_division(4, 0.0, 1.0);
+    test_circular_index_by_division(36, -3.141592653589793, 3.141592653589793);
+    test_circular_index_by_division(1000, 0.0, 6.283185307179586);
+    test_circular_index_by_division(7, -1.3, 7.7);
+    test_circular_index_by_division(36, -3.1415927f, 3.1415927f);
+    test_index_by_division(3, 0.1, 0.7);
+    test_index_by_division(7, -1.3, 7.7);
+    test_index_by_division(1000, 0.0, 0.1);
+    test_index_by_division(999, 1e-3, 17.3);
+    test_index_by_division(5, 1.0, -2.2);
+    test_index_by_division(100000, -3.3, 1e4);
+    test_index_by_division(3, 0.1f, 0.7f);
+    test_index_by_division(999, 1e-3f, 17.3f);
+    test_index_by_division(5, 1.0f, -2.2f);
+    // number of bins over range is not finite
+    test_index_by_division(10, 0.0, 1e-308);
+    test_index_by_division(100, 0.0f, 1e-37f);
+    BOOST_TEST_EQ(axis::regular<>(10, 0, 1e-308).index(5e-309), 5);
+    BOOST_TEST_EQ(axis::regular<float>(100, 0, 1e-37f).index(5e-38f), 50);
+    test_index_by_division(100, 1e-3, 1e3, tr::log{});
+    test_index_by_division(7, 0.3, 17.0, tr::log{});
+    test_index_by_division(1000, 1e-300, 1e300, tr::log{});
+    test_index_by_division(100, 1e-3f, 1e3f, tr::log{});
+    test_index_by_division(100, 0.0, 10.0, tr::sqrt{});
+    test_index_by_division(100, 1e-3, 1e3, tr::pow{0.5});
+    test_index_by_division(17, 0.1, 3.0, tr::pow{2.5});
+    test_index_by_division(100, 0.1, 10.0, tr::pow{-1});
+  }
+
+  // approximations used by log and pow transforms
+  {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<> dist(-700, 700);
+    for (int i = 0; i < 100000; ++i) {
+      const auto y = dist(gen);
+      const auto x = std::exp(y);
+      const auto e = tr::log::fast_forward_error();
+      BOOST_TEST_LT(std::abs(tr::log::fast_forward(x) - std::log(x)),
+                    e * (1 + std::abs(y)));
+      const auto p = tr::pow{y / 700 * 3};
+      const auto f = std::pow(x, p.power);
+      // approximation is NaN close to the limits of the double range
+      if (std::isnormal(f) && std::abs(std::log(f)) < 700) {
+        BOOST_TEST_LT(std::abs(p.fast_forward(x) - f),
+                      p.fast_forward_error() * (1 + std::abs(f)));
+      }
+    }
+    BOOST_TEST(std::isnan(tr::log::fast_forward(0)));
+    BOOST_TEST(std::isnan(tr::log::fast_forward(-1)));
+    const auto inf = std::numeric_limits<double>::infinity();
+    BOOST_TEST(std::isnan(tr::log::fast_forward(inf)));
+    BOOST_TEST(std::isnan(tr::log::fast_forward(std::numeric_limits<double>::min() / 2)));
+    BOOST_TEST(std::isnan(tr::pow{2}.fast_forward(1e200)));
+  }
+
   // iterators
   {
     test_axis_iterator(axis::regular<>(5, 0, 1), 0, 5);
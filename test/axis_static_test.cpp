@@ -0,0 +1,161 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/axis/static_integer.hpp>
+#include <boost/histogram/axis/static_regular.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/unsafe_access.hpp>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <ratio>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+template <class T>
+auto str(const T& t) {
+  std::ostringstream os;
+  os << t;
+  return os.str();
+}
+
+// static axis gives the same indices as the corresponding dynamic axis
+template <class Static, class Dynamic>
+void test_same_index(const Static& a, const Dynamic& b) {
+  const auto inf = std::numeric_limits<double>::infinity();
+  for (int i = 0; i <= a.size(); ++i) {
+    const auto x = b.value(i);
+    BOOST_TEST_EQ(a.value(i), x);
+    BOOST_TEST_EQ(a.index(x), b.index(x));
+    BOOST_TEST_EQ(a.index(std::nextafter(x, -inf)), b.index(std::nextafter(x, -inf)));
+    BOOST_TEST_EQ(a.index(std::nextafter(x, inf)), b.index(std::nextafter(x, inf)));
+    BOOST_TEST_EQ(a.index(x + 0.3 * (b.value(i + 1) - x)),
+                  b.index(x + 0.3 * (b.value(i + 1) - x)));
+  }
+}
+
+int main() {
+  // axis::static_regular
+  {
+    using A = axis::static_regular<4, -1, 1>;
+    static_assert(A::size() == 4, "");
+
+    A a("foo");
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    BOOST_TEST_EQ(a.value(0), -1);
+    BOOST_TEST_EQ(a.value(1), -0.5);
+    BOOST_TEST_EQ(a.value(4), 1);
+    BOOST_TEST_EQ(a.value(-1), -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.value(5), std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.bin(1).lower(), -0.5);
+    BOOST_TEST_EQ(a.bin(1).upper(), 0);
+    BOOST_TEST_EQ(a.index(-10), -1);
+    BOOST_TEST_EQ(a.index(-1), 0);
+    BOOST_TEST_EQ(a.index(0), 2);
+    BOOST_TEST_EQ(a.index(0.99), 3);
+    BOOST_TEST_EQ(a.index(1), 4);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 4);
+    BOOST_TEST_EQ(str(a), "static_regular(4, -1, 1, metadata=\"foo\", "
+                          "options=underflow | overflow)");
+    BOOST_TEST_EQ(axis::traits::width(a, 0), 0.5);
+
+    A b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    BOOST_TEST_EQ(a, (axis::static_regular<4, -10, 10, std::ratio<1, 10>>("foo")));
+    BOOST_TEST_NE(a, (axis::static_regular<4, -1, 2>("foo")));
+    test_axis_iterator(a, 0, a.size());
+  }
+
+  // static_regular with fractional range and without flow bins
+  {
+    auto a = axis::static_regular<10, -5, 5, std::ratio<1, 10>, axis::null_type,
+                                  axis::option::none_t>();
+    BOOST_TEST_EQ(a.value(0), -0.5);
+    BOOST_TEST_EQ(a.value(10), 0.5);
+    BOOST_TEST_EQ(axis::traits::extent(a), 10);
+    test_same_index(a, axis::regular<>(10, -0.5, 0.5));
+    test_same_index(axis::static_regular<100, 0, 314159, std::ratio<1, 100000>>(),
+                    axis::regular<>(100, 0, 3.14159));
+    test_same_index(axis::static_regular<7, 1, 3, std::ratio<1, 3>>(),
+                    axis::regular<>(7, 1.0 / 3, 1.0));
+  }
+
+  // axis::static_integer
+  {
+    using A = axis::static_integer<-1, 2>;
+    static_assert(A::size() == 3, "");
+
+    A a("bar");
+    BOOST_TEST_EQ(a.metadata(), "bar");
+    BOOST_TEST_EQ(a.value(0), -1);
+    BOOST_TEST_EQ(a.value(3), 2);
+    BOOST_TEST_EQ(a.value(-1), std::numeric_limits<int>::min());
+    BOOST_TEST_EQ(a.value(4), std::numeric_limits<int>::max());
+    BOOST_TEST_EQ(a.bin(1), 0);
+    BOOST_TEST_EQ(a.index(-2), -1);
+    BOOST_TEST_EQ(a.index(-1), 0);
+    BOOST_TEST_EQ(a.index(1), 2);
+    BOOST_TEST_EQ(a.index(2), 3);
+    BOOST_TEST_EQ(str(a), "static_integer(-1, 2, metadata=\"bar\", "
+                          "options=underflow | overflow)");
+    BOOST_TEST_EQ(axis::traits::width(a, 0), 0);
+
+    A b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    BOOST_TEST_NE(a, (axis::static_integer<-1, 3>("bar")));
+    test_axis_iterator(a, 0, a.size());
+  }
+
+  // make_static_histogram
+  {
+    auto h = make_static_histogram(axis::static_regular<4, 0, 1>("x"),
+                                   axis::static_integer<0, 3>("y"));
+    using S = std::decay_t<decltype(unsafe_access::storage(h))>;
+    static_assert(std::is_same<S, storage_adaptor<std::array<double, 30>>>::value, "");
+    BOOST_TEST_EQ(h.size(), 30);
+
+    h(0.1, 0);
+    h(0.6, 2);
+    h(0.6, 2);
+    h(-1, 5);
+    BOOST_TEST_EQ(h.at(0, 0), 1);
+    BOOST_TEST_EQ(h.at(2, 2), 2);
+    BOOST_TEST_EQ(h.at(-1, 3), 1);
+    BOOST_TEST_EQ(algorithm::sum(h), 4);
+
+    auto h2 = make_static_histogram<unsigned>(axis::static_integer<0, 3>());
+    h2(1);
+    BOOST_TEST_EQ(h2.at(1), 1u);
+    BOOST_TEST_EQ(h2.size(), 5);
+
+    // static histogram gives same result as dynamic histogram
+    auto h3 = make_histogram(axis::regular<>(4, 0, 1, "x"), axis::integer<>(0, 3, "y"));
+    h3(0.1, 0);
+    h3(0.6, 2);
+    h3(0.6, 2);
+    h3(-1, 5);
+    for (int i = -1; i < 5; ++i)
+      for (int j = -1; j < 4; ++j) BOOST_TEST_EQ(h.at(i, j), h3.at(i, j));
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,106 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/ostream.hpp>
+#include <boost/histogram/axis/top_k_category.hpp>
+#include <boost/histogram/axis/traits.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "utility_axis.hpp"
+
+using namespace boost::histogram;
+
+template <class T>
+auto str(const T& t) {
+  std::ostringstream os;
+  os << t;
+  return os.str();
+}
+
+int main() {
+  // bad_ctor
+  {
+    BOOST_TEST_THROWS(axis::top_k_category<>(0, 1, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::top_k_category<>(1, 0, 1), std::invalid_argument);
+    BOOST_TEST_THROWS(axis::top_k_category<>(1, 1, 0), std::invalid_argument);
+  }
+
+  // axis::top_k_category
+  {
+    axis::top_k_category<std::string> a{2, 2, 2, "foo"};
+    BOOST_TEST_EQ(a.size(), 0);
+    BOOST_TEST_EQ(a.k(), 2);
+    BOOST_TEST_EQ(a.counters(), 2);
+    BOOST_TEST_EQ(a.min_count(), 2);
+    BOOST_TEST_EQ(a.metadata(), "foo");
+    BOOST_TEST_EQ(a.options(), axis::option::overflow | axis::option::growth);
+    BOOST_TEST(axis::traits::static_options<decltype(a)>::test(axis::option::growth));
+
+    BOOST_TEST_EQ(a.update("A"), std::make_pair(0, 0));
+    BOOST_TEST_EQ(a.update("B"), std::make_pair(0, 0));
+    BOOST_TEST_EQ(a.index("A"), 0);
+    // counter of A reaches 2
+    BOOST_TEST_EQ(a.update("A"), std::make_pair(0, -1));
+    BOOST_TEST_EQ(a.size(), 1);
+    BOOST_TEST_EQ(a.index("A"), 0);
+    BOOST_TEST_EQ(a.update("A"), std::make_pair(0, 0));
+    // table is {B: 1, C: 1}, D decrements all counters and is not counted
+    BOOST_TEST_EQ(a.update("C"), std::make_pair(1, 0));
+    BOOST_TEST_EQ(a.update("D"), std::make_pair(1, 0));
+    BOOST_TEST_EQ(a.update("B"), std::make_pair(1, 0));
+    BOOST_TEST_EQ(a.update("B"), std::make_pair(1, -1));
+    BOOST_TEST_EQ(a.size(), 2);
+    // axis is full
+    BOOST_TEST_EQ(a.update("C"), std::make_pair(2, 0));
+    BOOST_TEST_EQ(a.update("C"), std::make_pair(2, 0));
+    BOOST_TEST_EQ(a.size(), 2);
+    BOOST_TEST_EQ(a.value(0), "A");
+    BOOST_TEST_EQ(a.value(1), "B");
+    BOOST_TEST_THROWS(a.value(2), std::out_of_range);
+    BOOST_TEST_EQ(str(a), "top_k_category(\"A\", \"B\", k=2, counters=2, min_count=2, "
+                          "metadata=\"foo\", options=overflow | growth)");
+
+    axis::top_k_category<std::string> b;
+    BOOST_TEST_NE(a, b);
+    b = a;
+    BOOST_TEST_EQ(a, b);
+    b.update("C");
+    BOOST_TEST_EQ(a, b);
+    test_axis_iterator(a, 0, 2);
+  }
+
+  // heavy hitters in a stream with a long tail
+  {
+    auto h = make_histogram(axis::top_k_category<int>(3, 10, 20));
+    std::default_random_engine gen(1);
+    std::uniform_int_distribution<int> tail(100, 1000000);
+    std::uniform_int_distribution<int> pick(0, 9);
+    for (int i = 0; i < 10000; ++i) {
+      const int r = pick(gen);
+      // 0 has 40%, 1 has 20%, 2 has 10%, the rest is random
+      h(r < 4 ? 0 : r < 6 ? 1 : r < 7 ? 2 : tail(gen));
+    }
+    const auto& a = h.axis();
+    BOOST_TEST_EQ(a.size(), 3);
+    BOOST_TEST_EQ(a.value(0), 0);
+    BOOST_TEST_EQ(a.value(1), 1);
+    BOOST_TEST_EQ(a.value(2), 2);
+    BOOST_TEST_EQ(h.size(), 4);
+    BOOST_TEST_EQ(algorithm::sum(h), 10000);
+    // all fills before promotion are in the overflow bin
+    BOOST_TEST_GT(h.at(0), 3900);
+    BOOST_TEST_GT(h.at(3), 3000);
+  }
+
+  return boost::report_errors();
+}
@@ -14,6 +14,7 @@
 #include <boost/histogram/detail/axes.hpp>
 #include <boost/histogram/detail/cat.hpp>
 #include <boost/histogram/detail/common_type.hpp>
+#include <boost/histogram/detail/crc32.hpp>
 #include <boost/histogram/detail/throw_exception.hpp>
 #include <boost/histogram/literals.hpp>
 #include <boost/histogram/storage_adaptor.hpp>
@@ -29,6 +30,14 @@ using namespace boost::histogram::literals;
 int main() {
   BOOST_TEST_EQ(detail::cat("foo", 1, "bar"), "foo1bar");
 
+  // crc32 check values, also for input lengths not divisible by 8
+  {
+    const char* s = "123456789";
+    BOOST_TEST_EQ(detail::crc32(s, 9), 0xCBF43926u);
+    BOOST_TEST_EQ(detail::crc32(s + 4, 5, detail::crc32(s, 4)), 0xCBF43926u);
+    BOOST_TEST_EQ(detail::crc32(s, 0), 0u);
+  }
+
   // literals
   {
     BOOST_TEST_TRAIT_SAME(std::integral_constant<unsigned, 0>, decltype(0_c));
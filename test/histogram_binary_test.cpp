@@ -0,0 +1,519 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/mean.hpp>
+#include <boost/histogram/accumulators/thread_safe.hpp>
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/axis/interned_string.hpp>
+#include <boost/histogram/binary.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+template <class H>
+std::string to_binary(const H& h, binary_encoding e = binary_encoding::raw,
+                      std::size_t chunk_size = 0) {
+  std::ostringstream os(std::ios::binary);
+  save_binary(os, h, e, chunk_size);
+  return os.str();
+}
+
+// load from stream and from memory, both must give the same result
+template <class H>
+void round_trip(const H& a, binary_encoding e = binary_encoding::raw,
+                std::size_t chunk_size = 0) {
+  const auto s = to_binary(a, e, chunk_size);
+
+  auto b = H();
+  std::istringstream is(s, std::ios::binary);
+  load_binary(is, b);
+  BOOST_TEST_EQ(a, b);
+
+  auto c = H();
+  load_binary(s.data(), s.size(), c);
+  BOOST_TEST_EQ(a, c);
+}
+
+template <class Tag>
+void run_tests() {
+  namespace tr = axis::transform;
+  using def = use_default;
+  using axis::option::none_t;
+
+  // mixed axes, like in histogram_serialization_test
+  {
+    auto a =
+        make(Tag(), axis::regular<double, def, def, none_t>(1, -1, 1, "reg"),
+             axis::circular<float, def, none_t>(1, 0.0, 1.0, "cir"),
+             axis::regular<double, tr::log, def, none_t>(1, 1, std::exp(2), "reg-log"),
+             axis::regular<double, tr::pow, std::vector<int>, axis::option::overflow_t>(
+                 tr::pow(0.5), 1, 1, 100, {1, 2, 3}),
+             axis::variable<double, def, none_t>({1.5, 2.5}, "var"),
+             axis::category<int, def, none_t>{3, 1},
+             axis::integer<int, axis::null_type, none_t>(1, 2),
+             axis::category<std::string>({"A", "BC"}));
+    a(0.5, 0.2, 2, 20, 2.2, 1, 1, "BC");
+    round_trip(a);
+  }
+
+  // loaded strings are interned
+  {
+    using axis::interned_string;
+    auto a = make(Tag(), axis::regular<double, def, interned_string>(2, 0, 1, "x"),
+                  axis::integer<int, interned_string>(0, 2, "y"));
+    a(0.5, 1);
+    round_trip(a);
+    const auto s = to_binary(a);
+    auto b = decltype(a)();
+    load_binary(s.data(), s.size(), b);
+    BOOST_TEST_EQ(b.axis(1).metadata().c_str(), a.axis(1).metadata().c_str());
+  }
+
+  // log_linear axes
+  {
+    auto a = make(Tag(), axis::log_linear<>(2, 1e-3, 1e3, "x"),
+                  axis::log_linear<unsigned>(1, 10, 1000));
+    a(0.1, 500);
+    round_trip(a);
+    const auto s = to_binary(a);
+    auto b = decltype(a)();
+    load_binary(s.data(), s.size(), b);
+    BOOST_TEST_EQ(b.axis(0).index(0.1), a.axis(0).index(0.1));
+  }
+
+  // static axes
+  {
+    auto a = make(Tag(), axis::static_regular<4, 0, 1>("x"),
+                  axis::static_integer<0, 3>("y"));
+    a(0.1, 0);
+    a(0.6, 2);
+    round_trip(a);
+
+    auto b = make_static_histogram(axis::static_regular<4, 0, 1>("x"),
+                                   axis::static_integer<0, 3>("y"));
+    b(0.1, 0);
+    b(0.6, 2);
+    b(-1, 5);
+    BOOST_TEST_NE(b, decltype(b)());
+    round_trip(b);
+  }
+
+  // top_k_category axis restores its counter table
+  {
+    auto a = make(Tag(), axis::top_k_category<std::string>(3, 2, 2, "x"));
+    for (auto x : {"A", "A", "B", "C", "B"}) a(x);
+    round_trip(a);
+    const auto s = to_binary(a);
+    auto b = decltype(a)();
+    load_binary(s.data(), s.size(), b);
+    // C has a counter of 1
+    a("C");
+    b("C");
+    BOOST_TEST_EQ(b, a);
+    BOOST_TEST_EQ(b.axis().index("C"), 2);
+  }
+
+  // dense storages
+  {
+    auto a = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 100));
+    for (int i = 0; i < 100; ++i) a(i, weight(i));
+    round_trip(a);
+
+    auto b = make_s(Tag(), weight_storage(), axis::regular<>(10, 0, 1));
+    b(0.5, weight(2));
+    b(0.1);
+    round_trip(b);
+
+    auto c = make_s(Tag(), std::vector<accumulators::mean<>>(), axis::integer<>(0, 3));
+    c(0, sample(1));
+    c(0, sample(3));
+    c(2, sample(4));
+    round_trip(c);
+
+    auto d = make_s(Tag(), std::array<unsigned, 10>(), axis::integer<>(0, 5));
+    d(1);
+    round_trip(d);
+
+    auto e = make_s(Tag(), dense_storage<accumulators::thread_safe<int>>(),
+                    axis::integer<>(0, 5));
+    e(1);
+    e(4);
+    round_trip(e);
+  }
+
+  // sparse storage
+  {
+    auto a = make_s(Tag(), std::map<std::size_t, double>(), axis::integer<>(0, 1000));
+    a(3);
+    a(500, weight(2.5));
+    round_trip(a);
+  }
+
+  // unlimited storage in all tiers
+  {
+    auto a = make_s(Tag(), unlimited_storage<>(), axis::integer<>(0, 4));
+    round_trip(a);
+    a(0);
+    round_trip(a);
+    a(1, weight(1000));
+    round_trip(a);
+    a(2, weight(100000));
+    round_trip(a);
+    a(3, weight(std::uint64_t(1) << 40));
+    round_trip(a);
+    for (int i = 0; i < 20; ++i) a(3, weight(std::numeric_limits<std::uint64_t>::max()));
+    round_trip(a);
+    a(0, weight(0.5));
+    round_trip(a);
+  }
+
+  // packed unlimited storage
+  {
+    auto a = make_s(Tag(), unlimited_storage<>(), axis::integer<>(0, 10000));
+    round_trip(a, binary_encoding::packed);
+    for (int i = 0; i < 10000; i += 97) a(i, weight(i % 7 + 1));
+    round_trip(a, binary_encoding::packed);
+    const auto raw = to_binary(a).size();
+    const auto packed = to_binary(a, binary_encoding::packed).size();
+    BOOST_TEST_LT(packed * 10, raw);
+
+    a(9999);
+    a(-1, weight(300));
+    round_trip(a, binary_encoding::packed);
+    a(5, weight(100000));
+    round_trip(a, binary_encoding::packed);
+    a(6, weight(std::uint64_t(1) << 40));
+    round_trip(a, binary_encoding::packed);
+    for (int i = 0; i < 20; ++i) a(3, weight(std::numeric_limits<std::uint64_t>::max()));
+    round_trip(a, binary_encoding::packed);
+    a(0, weight(0.5));
+    round_trip(a, binary_encoding::packed);
+
+    // cells are restored at the narrowest type which fits
+    auto b = make_s(Tag(), unlimited_storage<>(), axis::integer<>(0, 3));
+    b(0, weight(std::uint64_t(1) << 40));
+    b.at(0) = 0;
+    b(1, weight(1000));
+    const auto s = to_binary(b, binary_encoding::packed);
+    const auto info = read_binary_info(s.data(), s.size());
+    BOOST_TEST(info.encoding == binary_encoding::packed);
+    BOOST_TEST_EQ(info.tier, 1); // uint16_t
+    auto c = decltype(b)();
+    load_binary(s.data(), s.size(), c);
+    BOOST_TEST_EQ(b, c);
+    BOOST_TEST_EQ(unsafe_access::unlimited_storage_buffer(unsafe_access::storage(c)).type,
+                  1);
+
+    // other storages ignore the option
+    auto d = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 3));
+    d(1);
+    BOOST_TEST_EQ(to_binary(d, binary_encoding::packed), to_binary(d));
+    round_trip(d, binary_encoding::packed);
+
+    // corrupted run length
+    auto t = s;
+    const auto i = read_binary_info(t.data(), t.size());
+    const auto offset =
+        static_cast<std::size_t>(static_cast<const char*>(i.block) - t.data());
+    t[offset] = '\x7f';
+    auto e = decltype(b)();
+    BOOST_TEST_THROWS(load_binary(t.data(), t.size(), e), std::runtime_error);
+  }
+
+  // chunked blocks with checksums
+  {
+    auto a = make_s(Tag(), dense_storage<double>(), axis::regular<>(1000, 0, 1),
+                    axis::integer<>(0, 10));
+    for (int i = 0; i < 1000; ++i) a(i * 1e-3, i % 10, weight(i));
+    // raw block, one chunk, several chunks, chunk size not a multiple of the cell size
+    for (std::size_t n : {100000, 1000, 77}) round_trip(a, binary_encoding::raw, n);
+    auto a2 = make(Tag(), axis::integer<>(0, 1000));
+    for (int i = 0; i < 1000; i += 3) a2(i, weight(i));
+    round_trip(a2, binary_encoding::raw, 100);
+    round_trip(a2, binary_encoding::packed, 100);
+
+    auto b = make_s(Tag(), std::map<std::size_t, double>(), axis::integer<>(0, 1000));
+    b(3);
+    b(500, weight(2.5));
+    round_trip(b, binary_encoding::raw, 7);
+
+    auto c = make(Tag(), axis::integer<int, axis::null_type, none_t>(0, 1));
+    round_trip(c, binary_encoding::raw, 16);
+    c(0);
+    round_trip(c, binary_encoding::raw, 16);
+
+    const auto s = to_binary(a, binary_encoding::raw, 1000);
+    const auto info = read_binary_info(s.data(), s.size());
+    BOOST_TEST(info.chunked);
+    BOOST_TEST_EQ(info.block_size, 1002 * 12 * sizeof(double));
+    BOOST_TEST_EQ(s.size(), static_cast<const char*>(info.block) - s.data() +
+                                info.block_size + 97 * 8);
+
+    // corrupted chunks are detected
+    auto d = decltype(a)();
+    auto t = s;
+    t[t.size() - 100] ^= 1;
+    BOOST_TEST_THROWS(load_binary(t.data(), t.size(), d), std::runtime_error);
+    std::istringstream is(t, std::ios::binary);
+    BOOST_TEST_THROWS(load_binary(is, d), std::runtime_error);
+    std::istringstream is2(s.substr(0, s.size() - 10), std::ios::binary);
+    BOOST_TEST_THROWS(load_binary(is2, d), std::runtime_error);
+    BOOST_TEST_THROWS(load_binary(s.data(), s.size() - 10, d), std::runtime_error);
+    BOOST_TEST_EQ(d, decltype(a)());
+
+    // corrupt block size in header of chunked data does not cause a huge allocation
+    for (auto enc : {binary_encoding::raw, binary_encoding::packed}) {
+      const std::size_t block_size_pos = 64;
+      const std::uint64_t huge = std::uint64_t{1} << 60;
+      auto u = to_binary(b, enc, 7);
+      std::memcpy(&u[block_size_pos], &huge, sizeof(huge));
+      auto e = decltype(b)();
+      BOOST_TEST_THROWS(load_binary(u.data(), u.size(), e), std::runtime_error);
+      std::istringstream is3(u, std::ios::binary);
+      BOOST_TEST_THROWS(load_binary(is3, e), std::runtime_error);
+      BOOST_TEST_EQ(e, decltype(b)());
+    }
+  }
+
+  // delta snapshots
+  {
+    auto a = make_s(Tag(), tracking_storage<dense_storage<int>, 8>(),
+                    axis::integer<>(0, 100), axis::integer<>(0, 3));
+    a(1, 1);
+    auto b = decltype(a)();
+    const auto s = to_binary(a);
+    load_binary(s.data(), s.size(), b);
+    auto g = unsafe_access::storage(a).checkpoint();
+
+    a(50, 0);
+    a(51, 0, weight(3));
+    a(99, 2);
+    std::ostringstream os(std::ios::binary);
+    save_delta(os, a, g);
+    const auto d = os.str();
+    // two modified blocks of 8 cells with 4 bytes each, plus block indices
+    BOOST_TEST_LT(d.size(), 56 + 2 * (8 + 8 * 4) + 1);
+    BOOST_TEST_NE(a, b);
+    apply_delta(d.data(), d.size(), b);
+    BOOST_TEST_EQ(a, b);
+
+    // applying twice gives the same result
+    std::istringstream is(d, std::ios::binary);
+    apply_delta(is, b);
+    BOOST_TEST_EQ(a, b);
+
+    g = unsafe_access::storage(a).checkpoint();
+    std::ostringstream os2(std::ios::binary);
+    save_delta(os2, a, g);
+    BOOST_TEST_EQ(os2.str().size(), 56);
+
+    // delta since the start contains everything
+    auto c = make_s(Tag(), dense_storage<int>(), axis::integer<>(0, 100),
+                    axis::integer<>(0, 3));
+    std::ostringstream os3(std::ios::binary);
+    save_delta(os3, a, 0);
+    const auto d3 = os3.str();
+    apply_delta(d3.data(), d3.size(), c);
+    BOOST_TEST_EQ(a, c);
+
+    // invalid deltas do not modify the histogram
+    a(0, 0);
+    std::ostringstream os4(std::ios::binary);
+    save_delta(os4, a, g);
+    auto d4 = os4.str();
+    BOOST_TEST_THROWS(apply_delta(d4.data(), d4.size() - 1, c), std::runtime_error);
+    BOOST_TEST_THROWS(apply_delta(d4.data(), 10, c), std::runtime_error);
+    auto e = make_s(Tag(), dense_storage<int>(), axis::integer<>(0, 10));
+    BOOST_TEST_THROWS(apply_delta(d4.data(), d4.size(), e), std::runtime_error);
+    // cells of other type
+    auto f = make_s(Tag(), dense_storage<float>(), axis::integer<>(0, 100),
+                    axis::integer<>(0, 3));
+    BOOST_TEST_THROWS(apply_delta(d4.data(), d4.size(), f), std::runtime_error);
+    auto u = make_s(Tag(), dense_storage<unsigned>(), axis::integer<>(0, 100),
+                    axis::integer<>(0, 3));
+    BOOST_TEST_THROWS(apply_delta(d4.data(), d4.size(), u), std::runtime_error);
+    // payload larger than all cells, stream is not read
+    auto big = d4;
+    const std::uint64_t n = std::uint64_t{1} << 40;
+    std::memcpy(&big[48], &n, sizeof(n));
+    std::istringstream is4(big, std::ios::binary);
+    BOOST_TEST_THROWS(apply_delta(is4, c), std::runtime_error);
+    d4[56] = '\x7f'; // block index out of range
+    BOOST_TEST_THROWS(apply_delta(d4.data(), d4.size(), c), std::runtime_error);
+    BOOST_TEST_EQ(c.at(0, 0), 0);
+    BOOST_TEST_EQ(f.at(0, 0), 0);
+  }
+
+  // storage block is aligned and can be used in place
+  {
+    auto a = make(Tag(), axis::regular<>(10, 0, 1, "foo"));
+    a(0.5, weight(3.5)); // switches to double cells
+    const auto s = to_binary(a);
+    // copy into aligned memory
+    std::vector<double> mem(s.size() / sizeof(double) + 1);
+    std::memcpy(mem.data(), s.data(), s.size());
+    const auto info = read_binary_info(mem.data(), s.size());
+    BOOST_TEST_EQ(info.version, 1);
+    BOOST_TEST_EQ(info.rank, 1);
+    BOOST_TEST(info.storage_type == binary_storage::unlimited);
+    BOOST_TEST(info.encoding == binary_encoding::raw);
+    BOOST_TEST_EQ(info.cells, 12);
+    BOOST_TEST_EQ(info.value_size, sizeof(double));
+    BOOST_TEST_EQ(info.block_size, 12 * sizeof(double));
+    const auto offset = static_cast<const char*>(info.block) -
+                        reinterpret_cast<const char*>(mem.data());
+    BOOST_TEST_EQ(offset % 64, 0);
+    const auto cells = static_cast<const double*>(info.block);
+    BOOST_TEST_EQ(cells[6], 3.5);
+  }
+
+  // parallel loading from memory
+  {
+    auto a = make_s(Tag(), dense_storage<double>(), axis::integer<>(0, 1 << 17));
+    for (int i = 0; i < (1 << 17); i += 3) a(i, weight(i));
+    for (auto chunk_size : {0, 1 << 12}) {
+      const auto s = to_binary(a, binary_encoding::raw, chunk_size);
+      for (unsigned threads : {0u, 3u}) {
+        auto b = decltype(a)();
+        load_binary(execution::parallel_policy(threads), s.data(), s.size(), b);
+        BOOST_TEST_EQ(a, b);
+      }
+      auto c = decltype(a)();
+      load_binary(execution::seq, s.data(), s.size(), c);
+      BOOST_TEST_EQ(a, c);
+    }
+
+    // a corrupted chunk is detected by any thread, the histogram is unchanged
+    auto bad = to_binary(a, binary_encoding::raw, 1 << 12);
+    bad[bad.size() - 100] ^= 1;
+    auto d = decltype(a)();
+    const auto par4 = execution::parallel_policy(4);
+    BOOST_TEST_THROWS(load_binary(par4, bad.data(), bad.size(), d), std::runtime_error);
+    BOOST_TEST(d == decltype(a)());
+
+    // encoded blocks are decoded sequentially
+    auto e = make(Tag(), axis::integer<>(0, 1000));
+    for (int i = 0; i < 1000; i += 7) e(i);
+    const auto packed = to_binary(e, binary_encoding::packed, 64);
+    auto f = decltype(e)();
+    load_binary(execution::par, packed.data(), packed.size(), f);
+    BOOST_TEST_EQ(e, f);
+  }
+
+  // read-only view over the data
+  {
+    auto a = make_s(Tag(), dense_storage<double>(), axis::regular<>(4, 0, 1),
+                    axis::integer<>(0, 3));
+    a(0.1, 0);
+    a(0.6, 2, weight(2));
+    a(2.0, 1);
+    const auto s = to_binary(a);
+    std::vector<double> mem(s.size() / sizeof(double) + 1);
+    std::memcpy(mem.data(), s.data(), s.size());
+
+    using axes_t = std::decay_t<decltype(unsafe_access::axes(a))>;
+    histogram_view<axes_t> v;
+    load_binary(mem.data(), s.size(), v);
+    BOOST_TEST_EQ(v, a);
+    BOOST_TEST_EQ(v.at(2, 2), 2);
+    BOOST_TEST_EQ(v.at(4, 1), 1);
+    // cells are not copied
+    BOOST_TEST(static_cast<const void*>(unsafe_access::storage(v).data()) ==
+               read_binary_info(mem.data(), s.size()).block);
+
+    // unlimited storage with matching cells can be viewed
+    auto b = make(Tag(), axis::integer<>(0, 3));
+    b(1, weight(1.5));
+    const auto t = to_binary(b);
+    std::vector<double> mem2(t.size() / sizeof(double) + 1);
+    std::memcpy(mem2.data(), t.data(), t.size());
+    using axes2_t = std::decay_t<decltype(unsafe_access::axes(b))>;
+    histogram_view<axes2_t> w;
+    load_binary(mem2.data(), t.size(), w);
+    BOOST_TEST_EQ(w.at(1), 1.5);
+
+    // blocks which cannot be used in place are rejected, the view is unchanged
+    histogram_view<axes_t, float> vf;
+    BOOST_TEST_THROWS(load_binary(mem.data(), s.size(), vf), std::runtime_error);
+    const auto chunked = to_binary(a, binary_encoding::raw, 64);
+    BOOST_TEST_THROWS(load_binary(chunked.data(), chunked.size(), v), std::runtime_error);
+    auto c = make(Tag(), axis::integer<>(0, 3));
+    c(1);
+    const auto packed = to_binary(c, binary_encoding::packed);
+    BOOST_TEST_THROWS(load_binary(packed.data(), packed.size(), w), std::runtime_error);
+    BOOST_TEST_EQ(v, a);
+    BOOST_TEST_EQ(w.at(1), 1.5);
+  }
+
+  // invalid data
+  {
+    auto a = make(Tag(), axis::integer<>(0, 3));
+    a(1);
+    const auto s = to_binary(a);
+    auto b = a;
+    b.reset();
+
+    BOOST_TEST_THROWS(load_binary(s.data(), 10, b), std::runtime_error);
+    BOOST_TEST_THROWS(load_binary(s.data(), s.size() - 1, b), std::runtime_error);
+    std::istringstream is(s.substr(0, s.size() - 1), std::ios::binary);
+    BOOST_TEST_THROWS(load_binary(is, b), std::runtime_error);
+
+    auto bad = s;
+    bad[0] = 'X';
+    BOOST_TEST_THROWS(load_binary(bad.data(), bad.size(), b), std::runtime_error);
+
+    // hostile sizes of axes and offset of storage block in header
+    auto set_u64 = [](std::string& x, std::size_t pos, std::uint64_t v) {
+      std::memcpy(&x[pos], &v, sizeof(v));
+    };
+    const std::size_t axes_size_pos = 48, offset_pos = 56;
+    bad = s;
+    set_u64(bad, axes_size_pos, std::numeric_limits<std::uint64_t>::max());
+    BOOST_TEST_THROWS(load_binary(bad.data(), bad.size(), b), std::runtime_error);
+    std::istringstream is2(bad, std::ios::binary);
+    BOOST_TEST_THROWS(load_binary(is2, b), std::runtime_error);
+    bad = s;
+    set_u64(bad, axes_size_pos, (std::uint64_t{1} << 40) - 72);
+    set_u64(bad, offset_pos, std::uint64_t{1} << 40);
+    BOOST_TEST_THROWS(load_binary(bad.data(), bad.size(), b), std::runtime_error);
+    std::istringstream is3(bad, std::ios::binary);
+    BOOST_TEST_THROWS(load_binary(is3, b), std::runtime_error);
+
+    // histogram is unchanged if loading fails
+    BOOST_TEST_EQ(b.at(1), 0);
+
+    // different storage
+    auto c = make_s(Tag(), std::vector<int>(), axis::integer<>(0, 3));
+    BOOST_TEST_THROWS(load_binary(s.data(), s.size(), c), std::runtime_error);
+
+    // axes are replaced by those in the data
+    auto d = make(Tag(), axis::integer<>(0, 4));
+    d(3);
+    const auto t = to_binary(d);
+    load_binary(t.data(), t.size(), b);
+    BOOST_TEST_EQ(b, d);
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
@@ -11,6 +11,7 @@
 #include <boost/histogram/histogram.hpp>
 #include <string>
 #include <utility>
+#include <vector>
 #include "utility_histogram.hpp"
 #include "utility_meta.hpp"
 
@@ -193,6 +194,11 @@ void run_tests() {
     BOOST_TEST_EQ(h.at(0, 1), 1);
     BOOST_TEST_EQ(h.at(2, 3), 1);
     BOOST_TEST_EQ(algorithm::sum(h), 3);
+
+    // fill with columns gives same result
+    auto h2 = make(Tag(), reg_nogrow{2, 0.0, 1.0}, regular{2, 0.0, 1.0});
+    h2.fill(std::vector<std::vector<double>>{{0.0, -1.0, 2.0}, {0.0, -0.1, 1.1}});
+    BOOST_TEST_EQ(h2, h);
   }
 }
 
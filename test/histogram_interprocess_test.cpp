@@ -0,0 +1,89 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/project.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/interprocess.hpp>
+#include <boost/histogram/literals.hpp>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace boost::histogram;
+using namespace boost::histogram::literals; // to get _c suffix
+namespace ipc = boost::interprocess;
+
+const char* segment_name = "boost_histogram_interprocess_test";
+
+using reg = axis::regular<double, use_default, axis::null_type>;
+using integer = axis::integer<int, axis::null_type>;
+
+template <class Segment>
+auto& get(Segment& segment) {
+  return make_interprocess_histogram(segment, "h", reg(4, 0, 1), integer(0, 3));
+}
+
+// fill from a separate process
+int child() {
+  ipc::managed_shared_memory segment(ipc::open_only, segment_name);
+  auto& h = get(segment);
+  for (int i = 0; i < 1000; ++i) h((i % 4) * 0.25 + 0.1, i % 3);
+  return 0;
+}
+
+struct segment_remover {
+  segment_remover() { ipc::shared_memory_object::remove(segment_name); }
+  ~segment_remover() { ipc::shared_memory_object::remove(segment_name); }
+};
+
+int main(int argc, char** argv) {
+  if (argc == 2 && std::string(argv[1]) == "child") return child();
+
+  segment_remover remover;
+  ipc::managed_shared_memory segment(ipc::create_only, segment_name, 1 << 16);
+
+  auto& h = get(segment);
+  BOOST_TEST_EQ(h.rank(), 2);
+  BOOST_TEST_EQ(h.size(), 6 * 5);
+  BOOST_TEST_EQ(algorithm::sum(h), 0);
+  // second call finds existing histogram
+  BOOST_TEST_EQ(&get(segment), &h);
+  using H = std::decay_t<decltype(h)>;
+  BOOST_TEST_EQ(segment.find<H>("h").first, &h);
+
+  // several processes fill concurrently
+  const auto cmd = std::string("\"") + argv[0] + "\" child";
+  std::vector<int> status(4, -1);
+  std::vector<std::thread> threads;
+  for (auto& s : status)
+    threads.emplace_back([&cmd, &s] { s = std::system(cmd.c_str()); });
+  for (auto& t : threads) t.join();
+  for (auto s : status) BOOST_TEST_EQ(s, 0);
+
+  BOOST_TEST_EQ(algorithm::sum(h), 4000);
+  BOOST_TEST_EQ(h.at(0, 0), 4 * 84);
+  BOOST_TEST_EQ(h.at(1, 1), 4 * 84);
+  BOOST_TEST_EQ(h.at(0, 1), 4 * 83);
+
+  // algorithms return histograms in local memory
+  auto p = algorithm::project(h, 1_c);
+  static_assert(
+      std::is_same<std::decay_t<decltype(unsafe_access::storage(p))>,
+                   dense_storage<accumulators::thread_safe<std::uint64_t>>>::value,
+      "");
+  BOOST_TEST_EQ(p.at(0), 4 * 334);
+  BOOST_TEST_EQ(algorithm::sum(p), 4000);
+
+  segment.destroy<H>("h");
+  BOOST_TEST(segment.find<H>("h").first == nullptr);
+
+  return boost::report_errors();
+}
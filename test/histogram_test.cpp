@@ -362,6 +362,34 @@ void run_tests() {
     BOOST_TEST_EQ(h.at(2, 2), 0);
   }
 
+  // fill with columns
+  {
+    auto h = make(Tag(), axis::regular<>(2, -1, 1),
+                  axis::integer<int, axis::null_type, axis::option::none_t>(-1, 2));
+    auto h2 = h;
+    const std::vector<double> x = {-1, -1, -1, -10, 0.5, 0.5, 2};
+    const std::vector<double> y = {-1, 0, -10, 0, 1, 1, 0};
+    for (unsigned i = 0; i < x.size(); ++i) h(x[i], y[i]);
+    h2.fill(std::vector<std::vector<double>>{x, y});
+    BOOST_TEST_EQ(h2, h);
+    BOOST_TEST_EQ(algorithm::sum(h2), 6);
+
+    // more values than fit into one internal batch
+    std::vector<double> x2(2000), y2(2000);
+    for (unsigned i = 0; i < x2.size(); ++i) {
+      x2[i] = 0.0011 * i - 1.1;
+      y2[i] = i % 4 - 1;
+      h(x2[i], y2[i]);
+    }
+    h2.fill(std::vector<std::vector<double>>{x2, y2});
+    BOOST_TEST_EQ(h2, h);
+
+    BOOST_TEST_THROWS(h2.fill(std::vector<std::vector<double>>{x}),
+                      std::invalid_argument);
+    BOOST_TEST_THROWS(h2.fill(std::vector<std::vector<double>>{x, x2}),
+                      std::invalid_argument);
+  }
+
   // d2w
   {
     auto h = make_s(Tag(), std::vector<accumulators::weighted_sum<>>(),
@@ -0,0 +1,116 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/text.hpp>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+template <class H>
+std::string json(const H& h, coverage cov = coverage::inner,
+                 std::size_t chunk_size = 1 << 16) {
+  std::ostringstream os;
+  save_json(os, h, cov, chunk_size);
+  return os.str();
+}
+
+template <class H>
+std::string csv(const H& h, coverage cov = coverage::inner) {
+  std::ostringstream os;
+  save_csv(os, h, cov);
+  return os.str();
+}
+
+template <class Tag>
+void run_tests() {
+  // 1D with continuous axis
+  {
+    auto h = make(Tag(), axis::regular<>(2, 0, 1, "x"));
+    h(0.2);
+    h(0.7, weight(2));
+    BOOST_TEST_EQ(json(h),
+                  "{\"axes\":[{\"label\":\"x\",\"underflow\":true,\"overflow\":true,"
+                  "\"size\":2,\"edges\":[0,0.5,1]}],\"values\":[1,2]}");
+    BOOST_TEST_EQ(json(h, coverage::all),
+                  "{\"axes\":[{\"label\":\"x\",\"underflow\":true,\"overflow\":true,"
+                  "\"size\":2,\"edges\":[0,0.5,1]}],\"values\":[0,1,2,0]}");
+    BOOST_TEST_EQ(csv(h), "lower0,upper0,value\n0,0.5,1\n0.5,1,2\n");
+    BOOST_TEST_EQ(csv(h, coverage::all),
+                  "lower0,upper0,value\n-inf,0,0\n0,0.5,1\n0.5,1,2\n1,inf,0\n");
+    // tiny chunks give the same output
+    BOOST_TEST_EQ(json(h, coverage::inner, 1), json(h));
+  }
+
+  // 2D with discrete axes and accumulators
+  {
+    auto h = make_s(Tag(), std::vector<accumulators::weighted_sum<>>(),
+                    axis::integer<int, axis::null_type>(1, 3),
+                    axis::category<std::string>({"a", "b\""}, "cat\n"));
+    h(weight(2), 1, "a");
+    h(2, "b\"");
+    BOOST_TEST_EQ(json(h),
+                  "{\"axes\":[{\"underflow\":true,\"overflow\":true,\"size\":2,"
+                  "\"values\":[1,2]},{\"label\":\"cat\\u000a\",\"underflow\":false,"
+                  "\"overflow\":true,\"size\":2,\"values\":[\"a\",\"b\\\"\"]}],"
+                  "\"values\":[[2,4],[0,0],[0,0],[1,1]]}");
+    // nonzero cells are written with their indices
+    h(3, "c");
+    const auto nz = json(h, coverage::nonzero);
+    BOOST_TEST_EQ(nz.substr(nz.find("],\"values\"")),
+                  "],\"values\":[[2,4],[1,1],[1,1]],\"indices\":[[0,0],[1,1],[2,2]]}");
+    BOOST_TEST_EQ(csv(h),
+                  "bin0,bin1,value\n"
+                  "1,\"a\",\"2,4\"\n"
+                  "2,\"a\",\"0,0\"\n"
+                  "1,\"b\"\"\",\"0,0\"\n"
+                  "2,\"b\"\"\",\"1,1\"\n");
+    const auto all = csv(h, coverage::all);
+    BOOST_TEST_EQ(all.substr(0, all.find('\n', 16) + 1),
+                  "bin0,bin1,value\n,\"a\",\"0,0\"\n");
+  }
+
+  // transformed axis and numbers which need all digits
+  {
+    auto h = make(Tag(), axis::regular<double, axis::transform::log>(3, 1, 1e3));
+    h(5);
+    const auto s = csv(h);
+    std::istringstream is(s);
+    std::string line;
+    std::getline(is, line);
+    BOOST_TEST_EQ(line, "lower0,upper0,value");
+    std::vector<double> edges;
+    for (int i = 0; i < 3; ++i) {
+      std::getline(is, line);
+      edges.push_back(std::stod(line.substr(0, line.find(','))));
+    }
+    BOOST_TEST_EQ(std::stod(line.substr(line.find(',') + 1)), h.axis().value(3));
+    for (int i = 0; i < 3; ++i) BOOST_TEST_EQ(edges[i], h.axis().value(i));
+  }
+
+  // non-finite values are null in JSON
+  {
+    auto h = make_s(Tag(), std::vector<double>(), axis::integer<>(0, 2));
+    h.at(0) = std::numeric_limits<double>::infinity();
+    h.at(1) = 0.1;
+    const auto s = json(h);
+    BOOST_TEST_EQ(s.substr(s.find("\"values\":[n")), "\"values\":[null,0.1]}");
+    BOOST_TEST_EQ(csv(h), "bin0,value\n0,inf\n1,0.1\n");
+  }
+}
+
+int main() {
+  run_tests<static_tag>();
+  run_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}
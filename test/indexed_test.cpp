@@ -4,6 +4,7 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis/integer.hpp>
 #include <boost/histogram/axis/variable.hpp>
@@ -11,9 +12,12 @@
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/indexed.hpp>
 #include <boost/histogram/literals.hpp>
+#include <boost/histogram/storage_adaptor.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/list.hpp>
 #include <iterator>
+#include <map>
 #include <type_traits>
 #include <vector>
 #include "utility_histogram.hpp"
@@ -118,6 +122,93 @@ void run_density_tests(mp_list<IsDynamic, Coverage>) {
   }
 }
 
+template <class IsDynamic, class Coverage>
+void run_subrange_tests(mp_list<IsDynamic, Coverage>) {
+  auto h = make_s(IsDynamic(), std::vector<int>(), axis::integer<>(0, 3),
+                  axis::integer<int, axis::null_type, axis::option::none_t>(0, 2),
+                  axis::integer<int, axis::null_type, axis::option::overflow_t>(0, 4));
+  int n = 0;
+  for (auto&& x : h) x = ++n % 3 ? n : 0;
+
+  std::vector<std::vector<int>> ref;
+  for (auto&& x : indexed(h, Coverage()))
+    ref.push_back({x.index(0), x.index(1), x.index(2), *x});
+
+  const auto ind = indexed(h, Coverage());
+  BOOST_TEST_EQ(ind.size(), Coverage() == coverage::inner ? 3 * 2 * 4 : 5 * 2 * 5);
+
+  // concatenated sub-ranges reproduce the full iteration for any split
+  for (std::size_t step = 1; step <= ind.size() + 1; ++step) {
+    std::vector<std::vector<int>> result;
+    for (std::size_t i = 0; i < ind.size(); i += step) {
+      auto sub = ind.subrange(i, i + step);
+      BOOST_TEST_EQ(sub.size(), std::min(step, ind.size() - i));
+      for (auto&& x : sub) result.push_back({x.index(0), x.index(1), x.index(2), *x});
+    }
+    BOOST_TEST(result == ref);
+  }
+
+  // nested sub-ranges and clamping
+  auto sub = ind.subrange(5, 15).subrange(2, 100);
+  BOOST_TEST_EQ(sub.size(), 8);
+  auto it = sub.begin();
+  BOOST_TEST_EQ(**it, h.at(it->index(0), it->index(1), it->index(2)));
+  // with coverage::nonzero, positions also count empty cells
+  if (Coverage() != coverage::nonzero) BOOST_TEST_EQ(**it, ref[7][3]);
+  BOOST_TEST_EQ(ind.subrange(100, 200).size(), 0);
+  auto empty = ind.subrange(7, 3);
+  BOOST_TEST(empty.begin() == empty.end());
+}
+
+template <class IsDynamic, class Storage>
+void run_nonzero_tests(IsDynamic, Storage) {
+  // more than 64 cells, so that the bitmap has several words
+  auto h = make_s(IsDynamic(), Storage(), axis::integer<>(0, 10),
+                  axis::integer<int, axis::null_type, axis::option::none_t>(0, 3),
+                  axis::integer<int, axis::null_type, axis::option::overflow_t>(0, 7));
+
+  // empty histogram
+  {
+    auto ind = indexed(h, coverage::nonzero);
+    BOOST_TEST(ind.begin() == ind.end());
+  }
+
+  h(-1, 0, 0);
+  h(3, 1, 2, weight(2));
+  h(9, 2, 6);
+  h(10, 2, 7, weight(3)); // last cell
+  h(5, 0, 5);
+  h(5, 0, 5);
+
+  // reference: all cells with value
+  std::vector<std::vector<int>> ref;
+  for (auto&& x : indexed(h, coverage::all))
+    if (*x != 0) ref.push_back({x.index(0), x.index(1), x.index(2)});
+  BOOST_TEST_EQ(ref.size(), 5);
+
+  std::vector<std::vector<int>> nonzero;
+  for (auto&& x : indexed(h, coverage::nonzero)) {
+    BOOST_TEST_EQ(*x, h.at(x.index(0), x.index(1), x.index(2)));
+    nonzero.push_back({x.index(0), x.index(1), x.index(2)});
+  }
+  BOOST_TEST(nonzero == ref);
+
+  // copies of the range keep working
+  auto ind = indexed(h, coverage::nonzero);
+  auto ind2 = ind;
+  unsigned n = 0;
+  for (auto&& x : ind2) {
+    BOOST_TEST_EQ(x.indices().size(), 3);
+    ++n;
+  }
+  BOOST_TEST_EQ(n, 5);
+
+  // cells can be modified through the accessor
+  for (auto&& x : indexed(h, coverage::nonzero)) *x = typename Storage::value_type{};
+  auto ind3 = indexed(h, coverage::nonzero);
+  BOOST_TEST(ind3.begin() == ind3.end());
+}
+
 int main() {
   mp_for_each<mp_product<mp_list, mp_list<mp_false, mp_true>,
                          mp_list<std::integral_constant<coverage, coverage::inner>,
@@ -127,5 +218,18 @@ int main() {
         run_3d_tests(x);
         run_density_tests(x);
       });
+
+  mp_for_each<mp_product<mp_list, mp_list<mp_false, mp_true>,
+                         mp_list<std::integral_constant<coverage, coverage::inner>,
+                                 std::integral_constant<coverage, coverage::all>,
+                                 std::integral_constant<coverage, coverage::nonzero>>>>(
+      [](auto&& x) { run_subrange_tests(x); });
+
+  mp_for_each<mp_list<mp_false, mp_true>>([](auto tag) {
+    run_nonzero_tests(tag, std::vector<double>());
+    run_nonzero_tests(tag, unlimited_storage<>());
+    run_nonzero_tests(tag, weight_storage());
+    run_nonzero_tests(tag, storage_adaptor<std::map<std::size_t, double>>());
+  });
   return boost::report_errors();
 }
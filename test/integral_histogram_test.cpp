@@ -0,0 +1,142 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/regular.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/integral_histogram.hpp>
+#include <random>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+// sum over closed box by brute force
+template <class Histogram>
+double brute_sum(const Histogram& h, const std::vector<int>& first,
+                 const std::vector<int>& last) {
+  double r = 0;
+  for (auto&& x : indexed(h, coverage::all)) {
+    bool inside = true;
+    for (unsigned d = 0; d < h.rank(); ++d)
+      inside &= first[d] <= x.index(d) && x.index(d) <= last[d];
+    if (inside) r += *x;
+  }
+  return r;
+}
+
+template <class Histogram, class Integral>
+void check_boxes(const Histogram& h, const Integral& ih, std::mt19937& gen) {
+  for (unsigned k = 0; k < 50; ++k) {
+    std::vector<int> first(h.rank()), last(h.rank()), end(h.rank());
+    for (unsigned d = 0; d < h.rank(); ++d) {
+      const auto n = h.axis(d).size();
+      std::uniform_int_distribution<int> dis(-2, n + 1);
+      first[d] = dis(gen);
+      last[d] = dis(gen);
+      end[d] = last[d] + 1;
+    }
+    const auto expected = brute_sum(h, first, last);
+    BOOST_TEST_EQ(ih.sum_closed(first, last), expected);
+    BOOST_TEST_EQ(ih.sum(first, end), expected);
+  }
+}
+
+template <class Tag, class Policy>
+void run_tests(const Policy& policy) {
+  std::mt19937 gen(1);
+  std::normal_distribution<> val(0.5, 0.5);
+
+  // 1D
+  {
+    auto h = make(Tag(), axis::regular<>(20, 0, 1));
+    for (unsigned i = 0; i < 1000; ++i) h(val(gen));
+    auto ih = make_integral_histogram(h, policy);
+    BOOST_TEST_EQ(ih.rank(), 1);
+    BOOST_TEST_EQ(ih.sum(), algorithm::sum(h));
+    BOOST_TEST_EQ(ih.sum({0}, {20}), brute_sum(h, {0}, {19}));
+    BOOST_TEST_EQ(ih.sum({-1}, {21}), 1000);
+    BOOST_TEST_EQ(ih.sum({-1}, {0}), h.at(-1));
+    BOOST_TEST_EQ(ih.sum({20}, {21}), h.at(20));
+    BOOST_TEST_EQ(ih.sum_closed({3}, {3}), h.at(3));
+    BOOST_TEST_EQ(ih.sum({5}, {5}), 0);
+    BOOST_TEST_EQ(ih.sum({7}, {3}), 0);
+    BOOST_TEST_THROWS((void)ih.sum({0, 0}, {1, 1}), std::invalid_argument);
+    check_boxes(h, ih, gen);
+
+    // updates at high cells are folded in place, updates at low cells with one pass
+    for (unsigned i = 0; i < 40; ++i) {
+      h(0.99);
+      ih(0.99);
+    }
+    ih.flush();
+    check_boxes(h, ih, gen);
+    for (unsigned i = 0; i < 40; ++i) {
+      h(-1);
+      ih(-1);
+    }
+    ih.flush();
+    check_boxes(h, ih, gen);
+  }
+
+  // 3D with mixed flow bins
+  {
+    auto h = make(Tag(), axis::regular<>(7, 0, 1),
+                  axis::integer<int, axis::null_type, axis::option::none_t>(0, 4),
+                  axis::integer<int, axis::null_type, axis::option::overflow_t>(0, 5));
+    std::uniform_int_distribution<> idis(-1, 6);
+    for (unsigned i = 0; i < 5000; ++i) h(val(gen), idis(gen), idis(gen));
+    auto ih = make_integral_histogram(h, policy);
+    BOOST_TEST_EQ(ih.sum(), algorithm::sum(h));
+    check_boxes(h, ih, gen);
+
+    // incremental updates, enough to trigger several flushes
+    for (unsigned i = 0; i < 1000; ++i) {
+      const auto x = val(gen);
+      const auto y = idis(gen);
+      const auto z = idis(gen);
+      h(x, y, z);
+      ih(x, y, z);
+      if (i % 3 == 0) {
+        h(weight(2), x, y, z);
+        ih(weight(2), x, y, z);
+      }
+      if (i % 100 == 0) check_boxes(h, ih, gen);
+    }
+    check_boxes(h, ih, gen);
+    ih.flush();
+    check_boxes(h, ih, gen);
+
+    h.at(2, 1, 5) += 3;
+    ih.add_at({2, 1, 5}, 3);
+    check_boxes(h, ih, gen);
+  }
+}
+
+int main() {
+  run_tests<static_tag>(execution::seq);
+  run_tests<dynamic_tag>(execution::seq);
+  run_tests<static_tag>(execution::parallel_policy(3));
+  run_tests<dynamic_tag>(execution::parallel_policy(3));
+
+  // parallel build gives identical table
+  {
+    auto h = make_histogram(axis::integer<>(0, 100), axis::integer<>(0, 50));
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<> dis(-10, 110);
+    for (unsigned i = 0; i < 100000; ++i) h(dis(gen), dis(gen));
+    const auto a = make_integral_histogram(h);
+    const auto b = make_integral_histogram(h, execution::parallel_policy(4));
+    for (int i = -1; i <= 100; ++i)
+      for (int j = -1; j <= 50; ++j)
+        BOOST_TEST_EQ(a.sum({0, 0}, {i, j}), b.sum({0, 0}, {i, j}));
+  }
+
+  return boost::report_errors();
+}
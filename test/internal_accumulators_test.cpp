@@ -98,6 +98,15 @@ int main() {
     BOOST_TEST_EQ(c.count(), 8);
     BOOST_TEST_EQ(c.value(), 10);
     BOOST_TEST_IS_CLOSE(c.variance(), 25.714, 1e-3);
+
+    m_t d;
+    d += m_t(); // adding empty mean is a no-op
+    BOOST_TEST_EQ(d.count(), 0);
+    BOOST_TEST_EQ(d.value(), 0);
+    d += a;
+    d += m_t();
+    BOOST_TEST_EQ(d.count(), 4);
+    BOOST_TEST_EQ(d.value(), 10);
   }
 
   {
@@ -121,6 +130,11 @@ int main() {
     BOOST_TEST_EQ(b.sum_of_weights(), 4);
     BOOST_TEST_EQ(b.value(), 2);
     BOOST_TEST_IS_CLOSE(b.variance(), 0.615, 1e-3);
+
+    m_t c;
+    c += m_t(); // adding empty mean is a no-op
+    BOOST_TEST_EQ(c.sum_of_weights(), 0);
+    BOOST_TEST_EQ(c.value(), 0);
   }
 
   {
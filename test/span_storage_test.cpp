@@ -0,0 +1,175 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/algorithm/project.hpp>
+#include <boost/histogram/algorithm/reduce.hpp>
+#include <boost/histogram/algorithm/sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/axis/option.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/literals.hpp>
+#include <boost/histogram/make_histogram.hpp>
+#include <boost/histogram/span_storage.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+using namespace boost::histogram::literals; // to get _c suffix
+
+int main() {
+  // mutable storage
+  {
+    std::array<int, 3> mem = {{1, 2, 3}};
+    span_storage<int> s(mem.data(), mem.size());
+    BOOST_TEST_EQ(s.size(), 3);
+    BOOST_TEST_EQ(s[1], 2);
+    BOOST_TEST(s == mem);
+    BOOST_TEST_EQ(s.data(), mem.data());
+    s[1] = 5;
+    BOOST_TEST_EQ(mem[1], 5);
+
+    // copies refer to the same memory
+    auto s2 = s;
+    ++s2[0];
+    BOOST_TEST_EQ(mem[0], 2);
+    BOOST_TEST_EQ(s[0], 2);
+
+    // reset clears the cells, but cannot change their number
+    BOOST_TEST_THROWS(s.reset(4), std::length_error);
+    BOOST_TEST_EQ(mem[0], 2);
+    s.reset(3);
+    BOOST_TEST(s == std::vector<int>(3, 0));
+    BOOST_TEST_EQ(s.data(), mem.data());
+
+    // histogram over external memory
+    auto h = make_histogram_with(s, axis::integer<>(0, 1));
+    h(0);
+    h(0);
+    h(1);
+    BOOST_TEST_EQ(mem[1], 2);
+    BOOST_TEST_EQ(mem[2], 1);
+    BOOST_TEST_THROWS(make_histogram_with(s, axis::integer<>(0, 2)), std::length_error);
+  }
+
+  // buffers from an arena with a growth handler
+  {
+    std::vector<std::vector<double>> slabs;
+    auto grow = [&slabs](std::size_t n) {
+      slabs.emplace_back(n, 42);
+      return slabs.back().data();
+    };
+    span_storage<double> s(grow);
+    BOOST_TEST_EQ(s.size(), 0);
+    s.reset(3);
+    BOOST_TEST_EQ(slabs.size(), 1);
+    BOOST_TEST_EQ(s.data(), slabs[0].data());
+    BOOST_TEST(s == std::vector<double>(3, 0));
+    // same size only clears
+    s[0] = 1;
+    s.reset(3);
+    BOOST_TEST_EQ(slabs.size(), 1);
+    BOOST_TEST_EQ(s[0], 0);
+
+    // growing axis requests a larger buffer and moves the cells
+    auto h = make_histogram_with(s, axis::integer<double, use_default,
+                                                   axis::option::growth_t>(0, 2));
+    BOOST_TEST_EQ(slabs.size(), 2);
+    h(0);
+    h(1, weight(2));
+    h(3);
+    BOOST_TEST_EQ(slabs.size(), 3);
+    BOOST_TEST_EQ(h.axis().size(), 4);
+    BOOST_TEST_EQ(unsafe_access::storage(h).data(), slabs[2].data());
+    BOOST_TEST_EQ(slabs[2].size(), 4);
+    BOOST_TEST_EQ(h.at(0), 1);
+    BOOST_TEST_EQ(h.at(1), 2);
+    BOOST_TEST_EQ(h.at(2), 0);
+    BOOST_TEST_EQ(h.at(3), 1);
+
+    // handler which refuses to grow
+    span_storage<double> s2(slabs[0].data(), 3, [](std::size_t) -> double* {
+      return nullptr;
+    });
+    BOOST_TEST_THROWS(s2.reset(4), std::length_error);
+    BOOST_TEST_EQ(s2.data(), slabs[0].data());
+  }
+
+  // read-only storage
+  {
+    const std::vector<double> mem = {1, 2, 3};
+    span_storage<const double> s(mem.data(), mem.size());
+    BOOST_TEST_EQ(s.size(), 3);
+    BOOST_TEST_EQ(s[2], 3);
+    BOOST_TEST(s == mem);
+    BOOST_TEST_THROWS(s.reset(3), std::logic_error);
+    static_assert(std::is_same<decltype(s[0]), const double&>::value, "");
+    static_assert(std::is_same<decltype(*s.begin()), const double&>::value, "");
+
+    span_storage<const double> empty;
+    empty.reset(0);
+    BOOST_TEST_EQ(empty.size(), 0);
+  }
+
+  // read-only histogram view
+  {
+    // 2D histogram with 3 x 4 cells, including flow bins
+    std::vector<double> mem(12);
+    for (unsigned i = 0; i < mem.size(); ++i) mem[i] = i;
+    const auto axes = std::make_tuple(axis::integer<>(0, 1), axis::integer<>(0, 2));
+    auto v = make_histogram_view(mem.data(), mem.size(), axes);
+    BOOST_TEST_EQ(v.rank(), 2);
+    BOOST_TEST_EQ(v.size(), 12);
+    BOOST_TEST_EQ(v.at(-1, -1), 0);
+    BOOST_TEST_EQ(v.at(0, 0), 4);
+    BOOST_TEST_EQ(v.at(1, 2), 11);
+    BOOST_TEST_EQ(algorithm::sum(v), 66);
+
+    double inner = 0;
+    for (auto&& x : indexed(v)) inner += *x;
+    BOOST_TEST_EQ(inner, 4 + 7);
+
+    // algorithms return histograms which own their cells
+    auto p = algorithm::project(v, 1_c);
+    static_assert(std::is_same<std::decay_t<decltype(unsafe_access::storage(p))>,
+                               dense_storage<double>>::value,
+                  "");
+    BOOST_TEST_EQ(p.at(-1), 0 + 1 + 2);
+    BOOST_TEST_EQ(p.at(0), 3 + 4 + 5);
+    BOOST_TEST_EQ(p.at(2), 9 + 10 + 11);
+
+    auto r = algorithm::reduce(v, algorithm::slice(1, 0, 1));
+    static_assert(std::is_same<std::decay_t<decltype(unsafe_access::storage(r))>,
+                               dense_storage<double>>::value,
+                  "");
+    BOOST_TEST_EQ(r.axis(1).size(), 1);
+    BOOST_TEST_EQ(r.at(0, -1), 1);
+    BOOST_TEST_EQ(r.at(0, 0), 4);
+    BOOST_TEST_EQ(r.at(0, 1), 7 + 10);
+    BOOST_TEST_EQ(algorithm::sum(r), 66);
+
+    auto q = v + v;
+    static_assert(std::is_same<std::decay_t<decltype(unsafe_access::storage(q))>,
+                               dense_storage<double>>::value,
+                  "");
+    BOOST_TEST_EQ(q.at(1, 2), 22);
+    BOOST_TEST_EQ(mem[11], 11);
+
+    // view on histogram with axes in vector
+    const auto vaxes = std::vector<axis::integer<>>{axis::integer<>(0, 10)};
+    auto w = make_histogram_view(mem.data(), mem.size(), vaxes);
+    BOOST_TEST_EQ(w.at(9), 10);
+    BOOST_TEST_EQ(algorithm::sum(w), 66);
+
+    BOOST_TEST_THROWS(make_histogram_view(mem.data(), 11, axes), std::invalid_argument);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,106 @@
+// Copyright 2019 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/accumulators/weighted_sum.hpp>
+#include <boost/histogram/axis/integer.hpp>
+#include <boost/histogram/detail/throw_exception.hpp>
+#include <boost/histogram/indexed.hpp>
+#include <boost/histogram/tracking_storage.hpp>
+#include <boost/histogram/unlimited_storage.hpp>
+#include <vector>
+#include "utility_histogram.hpp"
+
+using namespace boost::histogram;
+
+template <class S>
+std::vector<std::size_t> modified(const S& s, std::uint64_t since) {
+  std::vector<std::size_t> r;
+  for (std::size_t i = 0; i < s.block_count(); ++i)
+    if (s.is_modified(i, since)) r.push_back(i);
+  return r;
+}
+
+template <class Storage>
+void run_storage_tests() {
+  using S = tracking_storage<Storage, 4>;
+  S s;
+  s.reset(10);
+  BOOST_TEST_EQ(s.size(), 10);
+  BOOST_TEST_EQ(s.block_count(), 3);
+  BOOST_TEST_EQ(s.generation(), 1);
+  BOOST_TEST_EQ(modified(s, 0).size(), 3);
+
+  const auto g = s.checkpoint();
+  BOOST_TEST_EQ(g, 1);
+  BOOST_TEST_EQ(s.generation(), 2);
+  BOOST_TEST(modified(s, g).empty());
+
+  ++s[5];
+  BOOST_TEST_EQ(s[5], 1);
+  BOOST_TEST(modified(s, g) == std::vector<std::size_t>{1});
+  BOOST_TEST_EQ(s.block_generation(1), 2);
+  BOOST_TEST_EQ(s.block_generation(0), 1);
+
+  // reading through const storage does not mark blocks
+  const auto& cs = s;
+  double sum = 0;
+  for (auto&& x : cs) sum += x;
+  BOOST_TEST_EQ(sum, 1);
+  BOOST_TEST_EQ(cs[9], 0);
+  BOOST_TEST(modified(s, g) == std::vector<std::size_t>{1});
+
+  // writing through iterator marks blocks
+  auto it = s.begin() + 9;
+  BOOST_TEST(modified(s, g) == std::vector<std::size_t>{1});
+  *it += 2;
+  BOOST_TEST(modified(s, g) == (std::vector<std::size_t>{1, 2}));
+  BOOST_TEST_EQ(cs[9], 2);
+
+  const auto g2 = s.checkpoint();
+  BOOST_TEST(modified(s, g2).empty());
+  BOOST_TEST(modified(s, g) == (std::vector<std::size_t>{1, 2}));
+
+  s.reset(6);
+  BOOST_TEST_EQ(s.block_count(), 2);
+  BOOST_TEST_EQ(modified(s, g2).size(), 2);
+
+  S s2(Storage{});
+  BOOST_TEST_EQ(s2.size(), 0);
+  BOOST_TEST_EQ(s2.block_count(), 0);
+}
+
+template <class Tag>
+void run_histogram_tests() {
+  auto h = make_s(Tag(), tracking_storage<>(), axis::integer<>(0, 1000));
+  BOOST_TEST_EQ(unsafe_access::storage(h).block_count(), 4);
+  const auto g = unsafe_access::storage(h).checkpoint();
+  h(1);
+  h(700, weight(2));
+  BOOST_TEST_EQ(h.at(1), 1);
+  BOOST_TEST_EQ(h.at(700), 2);
+  BOOST_TEST(modified(unsafe_access::storage(h), g) == (std::vector<std::size_t>{0, 2}));
+
+  const auto g2 = unsafe_access::storage(h).checkpoint();
+  h *= 2;
+  BOOST_TEST_EQ(h.at(700), 4);
+  BOOST_TEST_EQ(modified(unsafe_access::storage(h), g2).size(), 4);
+
+  auto h2 = make_s(Tag(), tracking_storage<weight_storage, 16>(), axis::integer<>(0, 20));
+  h2(3, weight(2));
+  BOOST_TEST_EQ(h2.at(3).variance(), 4);
+}
+
+int main() {
+  run_storage_tests<dense_storage<double>>();
+  run_storage_tests<dense_storage<int>>();
+  run_storage_tests<unlimited_storage<>>();
+
+  run_histogram_tests<static_tag>();
+  run_histogram_tests<dynamic_tag>();
+
+  return boost::report_errors();
+}